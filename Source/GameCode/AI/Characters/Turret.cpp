@@ -5,6 +5,7 @@
 #include "Components/Weapon/WeaponBarellComponent.h"
 #include "AIController.h"
 #include <Net/UnrealNetwork.h>
+#include "Subsystems/FireScheduler/FireSchedulerSubsystem.h"
 
 
 ATurret::ATurret()
@@ -127,12 +128,12 @@ void ATurret::SetCurrentTurretState(ETurretState NewState)
 	{
 		case ETurretState::Searching:
 		{
-			GetWorld()->GetTimerManager().ClearTimer(ShotTimer);
+			GetWorld()->GetSubsystem<UFireSchedulerSubsystem>()->StopFire(this);
 		}
 			break;
 		case ETurretState::Firing:
 		{
-			GetWorld()->GetTimerManager().SetTimer(ShotTimer, this, &ATurret::MakeShot, GetFireInterval(), true, FireDelayTime);
+			GetWorld()->GetSubsystem<UFireSchedulerSubsystem>()->StartFire(this, GetFireInterval(), FireDelayTime, FOnScheduledShot::CreateUObject(this, &ATurret::MakeShot));
 			break;
 		}
 			
@@ -151,13 +152,15 @@ float ATurret::GetFireInterval() const
 
 }
 
-void ATurret::MakeShot()
+bool ATurret::MakeShot(float ShotTimeOffset)
 {
 	FVector ShotLocation = WeaponBarell->GetComponentLocation();
 	FVector ShotDirection = WeaponBarell->GetComponentRotation().RotateVector(FVector::ForwardVector);
 	float SpreadAngle = FMath::DegreesToRadians(BulletSpreadAngle);
 	
-	WeaponBarell->Shot(ShotLocation, ShotDirection, SpreadAngle);
+	WeaponBarell->Shot(ShotLocation, ShotDirection, SpreadAngle, ShotTimeOffset);
+
+	return true;
 
 }
 
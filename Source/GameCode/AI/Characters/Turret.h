@@ -88,8 +88,6 @@ private:
 	void OnRep_CurrentTarget();
 	
 	float GetFireInterval() const;
-	void MakeShot();
-
-	FTimerHandle  ShotTimer;
+	bool MakeShot(float ShotTimeOffset);
 
 };
@@ -7,6 +7,10 @@
 #include "Components/CharacterComponents/AIPatrollingComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "GameCodeTypes.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/LedgeDetectorComponent.h"
+#include "Actors/Navigation/MantlePointsActor.h"
 
 
 void AGCAICharacterController::SetPawn(APawn* InPawn)
@@ -50,6 +54,34 @@ void AGCAICharacterController::OnMoveCompleted(FAIRequestID RequestID, const FPa
 	TryMoveToNextTarget();
 }
 
+void AGCAICharacterController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	TryMantle();
+}
+
+void AGCAICharacterController::TryMantle()
+{
+	if (!bCanMantle || !CachedAICharacter.IsValid() || GetMoveStatus() != EPathFollowingStatus::Moving)
+	{
+		return;
+	}
+
+	FMantlePoint MantlePoint;
+	if (!CachedAICharacter->GetLedgeDetectorComponent()->FindBakedMantlePoint(MantlePoint))
+	{
+		return;
+	}
+
+	// Only mantle point whose nav link is the current path segment is used, other ledges along the path are ignored.
+	FVector LandingLocation = MantlePoint.Ledge.Location - CachedAICharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * FVector::UpVector;
+	if (FVector::DistSquared(GetPathFollowingComponent()->GetCurrentTargetLocation(), LandingLocation) <= FMath::Square(MantleLandingReachRadius))
+	{
+		CachedAICharacter->Mantle();
+	}
+}
+
 void AGCAICharacterController::SetupPatrolling()
 {
 	UAIPatrollingComponent* PatrollingComponet = CachedAICharacter->GetPatrollingComponent();
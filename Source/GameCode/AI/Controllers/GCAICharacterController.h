@@ -20,6 +20,8 @@ public:
 	virtual void ActorsPerceptionUpdated(const TArray<AActor *>& UpdatedActors) override;
 
 	virtual void OnMoveCompleted(FAIRequestID RequestID, const FPathFollowingResult& Result) override;
+
+	virtual void Tick(float DeltaSeconds) override;
 protected:
 	
 	void SetupPatrolling();
@@ -27,9 +29,19 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement")
 	float TargetReachRadius = 100.0f;
 
+	/** Mantle at baked mantle points when the path goes through their nav links */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement")
+	bool bCanMantle = true;
+
+	/** Path segment ending closer than this to the landing location of a mantle point goes through its nav link */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement")
+	float MantleLandingReachRadius = 100.0f;
+
 private:
 	void TryMoveToNextTarget();
 
+	void TryMantle();
+
 	bool IsTargetReached(FVector TargetLocation) const;
 
 	TWeakObjectPtr<AGCAICharacter> CachedAICharacter;
@@ -4,6 +4,7 @@
 #include "ThrowableItem.h"
 #include "Pawns/Character/GCBaseCharacter.h"
 #include "../../Projectiles/GCProjectile.h"
+#include "Subsystems/ProjectilePool/ProjectilePoolSubsystem.h"
 
 void AThrowableItem::Throw()
 {
@@ -40,10 +41,9 @@ void AThrowableItem::Throw()
 
 	FVector SpawnLocation = PlayerViewPoint + ViewDirection * SocketInViewSpace.X;
 
-	AGCProjectile* Projectile = GetWorld()->SpawnActor<AGCProjectile>(ProjectileClass, SpawnLocation, FRotator::ZeroRotator);
+	AGCProjectile* Projectile = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>()->AcquireProjectile(ProjectileClass, SpawnLocation, FRotator::ZeroRotator, GetOwner());
 	if (IsValid(Projectile))
 	{
-		Projectile->SetOwner(GetOwner());
 		Projectile->LaunchProjectile(LaunchDirection.GetSafeNormal());
 	}
 
@@ -6,6 +6,7 @@
 #include "GameCodeTypes.h"
 #include "Pawns/Character/GCBaseCharacter.h"
 #include "GameFramework/PlayerController.h"
+#include "Subsystems/FireScheduler/FireSchedulerSubsystem.h"
 
 ARangeWeaponItem::ARangeWeaponItem()
 {
@@ -24,14 +25,19 @@ ARangeWeaponItem::ARangeWeaponItem()
 
 void ARangeWeaponItem::StartFire()
 {
-	if (GetWorld()->GetTimerManager().IsTimerActive(ShotTimer))
+	UFireSchedulerSubsystem* FireScheduler = GetWorld()->GetSubsystem<UFireSchedulerSubsystem>();
+	if (FireScheduler->IsFireScheduled(this))
 	{
 		return;
 	}
 
 	bIsFiring = true;
 
-	MakeShot();
+	if (MakeShot(0.0f))
+	{
+		const float ShotInterval = GetShotTimerInterval();
+		FireScheduler->StartFire(this, ShotInterval, ShotInterval, FOnScheduledShot::CreateUObject(this, &ARangeWeaponItem::OnScheduledShot));
+	}
 	
 	
 }
@@ -216,12 +222,12 @@ float ARangeWeaponItem::GetCurrentBulletSpreadAngle() const
 	return FMath::DegreesToRadians(AngleInDegress);
 }
 
-void ARangeWeaponItem::MakeShot()
+bool ARangeWeaponItem::MakeShot(float ShotTimeOffset)
 {
 	AGCBaseCharacter* CharacterOwner = GetCharacterOwner();
 	if (!IsValid(CharacterOwner))
 	{
-		return;
+		return false;
 	}
 
 	if (!CanShoot())
@@ -231,13 +237,17 @@ void ARangeWeaponItem::MakeShot()
 		{
 			CharacterOwner->Reload();
 		}
-		return;
+		return false;
 	}
 
 	EndReload(false);
 
-	CharacterOwner->PlayAnimMontage(CharacterFireMontage);
-	PlayAnimMontage(WeaponFireMontage);
+	if (LastFireMontageFrame != GFrameCounter)
+	{
+		LastFireMontageFrame = GFrameCounter;
+		CharacterOwner->PlayAnimMontage(CharacterFireMontage);
+		PlayAnimMontage(WeaponFireMontage);
+	}
 	
 	FVector ShotLocation;
 	FRotator ShotRotation;
@@ -253,21 +263,24 @@ void ARangeWeaponItem::MakeShot()
 		ShotRotation = CharacterOwner->GetBaseAimRotation();
 	}
 
+	// Shot that was due earlier in the frame starts where the owner was at that time.
+	ShotLocation -= CharacterOwner->GetVelocity() * ShotTimeOffset;
+
 	FVector ShotDirection = ShotRotation.RotateVector(FVector::ForwardVector);
 	
 	SetAmmo(Ammo - 1);
 
-	WeaponBarell->Shot(ShotLocation, ShotDirection, GetCurrentBulletSpreadAngle());
-
-	GetWorld()->GetTimerManager().SetTimer(ShotTimer, this, &ARangeWeaponItem::OnShotTimerElapsed, GetShotTimerInterval(), false);
+	WeaponBarell->Shot(ShotLocation, ShotDirection, GetCurrentBulletSpreadAngle(), ShotTimeOffset);
 
+	return true;
 }
 
-void ARangeWeaponItem::OnShotTimerElapsed()
+bool ARangeWeaponItem::OnScheduledShot(float ShotTimeOffset)
 {
+	// Fire interval after the last shot has passed, the weapon can be fired again.
 	if (!bIsFiring)
 	{
-		return;
+		return false;
 	}
 
 	switch (WeaponFireMode)
@@ -275,17 +288,19 @@ void ARangeWeaponItem::OnShotTimerElapsed()
 		case EWeaponFireMode::Single:
 		{
 			StopFire();
-			break;
+			return false;
 			
 		}
 		
 		case EWeaponFireMode::FullAuto:
 		{
-			MakeShot();
+			return MakeShot(ShotTimeOffset);
 
 		}
 
 	}
+
+	return false;
 }
 
 float ARangeWeaponItem::GetShotTimerInterval() const
@@ -149,14 +149,16 @@ private:
 	bool bIsFiring = false;
 
 	float GetCurrentBulletSpreadAngle() const;
-	void MakeShot();
+	/** Returns false if there was no shot. @ShotTimeOffset is how long ago in this frame the shot was due. */
+	bool MakeShot(float ShotTimeOffset);
 
-	void OnShotTimerElapsed();
+	bool OnScheduledShot(float ShotTimeOffset);
 
 	float GetShotTimerInterval() const;
 	float PlayAnimMontage(UAnimMontage* AnimMontage);
 	void StopAnimMontage(UAnimMontage* AnimMontage, float BlendOutTime = 0.0f);
 
-	FTimerHandle ShotTimer;
 	FTimerHandle ReloadTimer;
+	/** Fire montages are played once per frame even if several shots are fired */
+	uint64 LastFireMontageFrame = 0;
 };
@@ -0,0 +1,240 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Actors/Navigation/MantlePointsActor.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "AI/NavigationSystemBase.h"
+#include "AI/NavigationSystemHelpers.h"
+#include "AI/Navigation/NavLinkDefinition.h"
+#include "Pawns/Character/GCBaseCharacter.h"
+#include "Subsystems/MantlePoints/MantlePointsSubsystem.h"
+#include "GameCodeTypes.h"
+
+DEFINE_LOG_CATEGORY(LogMantlePoints)
+
+AMantlePointsActor::AMantlePointsActor()
+{
+	BakeVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("BakeVolume"));
+	BakeVolume->SetBoxExtent(FVector(1000.0f, 1000.0f, 500.0f));
+	BakeVolume->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetRootComponent(BakeVolume);
+
+	SetActorHiddenInGame(true);
+}
+
+void AMantlePointsActor::BeginPlay()
+{
+	Super::BeginPlay();
+
+	GetWorld()->GetSubsystem<UMantlePointsSubsystem>()->RegisterMantlePoints(this);
+}
+
+void AMantlePointsActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UMantlePointsSubsystem* MantlePointsSubsystem = GetWorld()->GetSubsystem<UMantlePointsSubsystem>();
+	if (IsValid(MantlePointsSubsystem))
+	{
+		MantlePointsSubsystem->UnregisterMantlePoints(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AMantlePointsActor::GetNavigationData(FNavigationRelevantData& Data) const
+{
+	if (!bCreateNavLinks)
+	{
+		return;
+	}
+
+	// Links are in actor space and connect capsule bottoms, so they snap to the navmesh below and above the ledge.
+	const FTransform& ActorTransform = GetActorTransform();
+	const FVector CapsuleBottomOffset = BakedCapsuleHalfHeight * FVector::UpVector;
+
+	TArray<FNavigationLink> NavLinks;
+	NavLinks.Reserve(MantlePoints.Num());
+	for (const FMantlePoint& MantlePoint : MantlePoints)
+	{
+		FNavigationLink& NavLink = NavLinks.Emplace_GetRef(
+			ActorTransform.InverseTransformPosition(MantlePoint.StartLocation - CapsuleBottomOffset),
+			ActorTransform.InverseTransformPosition(MantlePoint.Ledge.Location - CapsuleBottomOffset));
+		NavLink.Direction = ENavLinkDirection::LeftToRight;
+	}
+
+	NavigationHelper::ProcessNavLinkAndAppend(&Data.Modifiers, this, NavLinks);
+}
+
+FBox AMantlePointsActor::GetNavigationBounds() const
+{
+	FBox Bounds(ForceInit);
+	for (const FMantlePoint& MantlePoint : MantlePoints)
+	{
+		Bounds += MantlePoint.StartLocation;
+		Bounds += MantlePoint.Ledge.Location;
+	}
+
+	return Bounds.ExpandBy(BakedCapsuleHalfHeight);
+}
+
+bool AMantlePointsActor::IsNavigationRelevant() const
+{
+	return bCreateNavLinks && MantlePoints.Num() > 0;
+}
+
+TSubclassOf<AGCBaseCharacter> AMantlePointsActor::GetCharacterClass() const
+{
+	return CharacterClass;
+}
+
+const FMantlePoint* AMantlePointsActor::FindMantlePoint(const FVector& Location, float Yaw, float MaxDistance, float MaxYawDelta, float& OutDistanceSquared) const
+{
+	const FMantlePoint* ClosestMantlePoint = nullptr;
+	OutDistanceSquared = FMath::Square(MaxDistance);
+
+	const FIntPoint MinCell = GetCell(Location - FVector(MaxDistance, MaxDistance, 0.0f));
+	const FIntPoint MaxCell = GetCell(Location + FVector(MaxDistance, MaxDistance, 0.0f));
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const FMantlePointCell* Cell = Cells.Find(FIntPoint(CellX, CellY));
+			if (Cell == nullptr)
+			{
+				continue;
+			}
+
+			for (int32 i = Cell->FirstIndex; i < Cell->FirstIndex + Cell->Count; ++i)
+			{
+				const FMantlePoint& MantlePoint = MantlePoints[i];
+				float DistanceSquared = FVector::DistSquared(MantlePoint.StartLocation, Location);
+				if (DistanceSquared > OutDistanceSquared || FMath::Abs(FRotator::NormalizeAxis(MantlePoint.Ledge.Rotation.Yaw - Yaw)) > MaxYawDelta)
+				{
+					continue;
+				}
+
+				ClosestMantlePoint = &MantlePoint;
+				OutDistanceSquared = DistanceSquared;
+			}
+		}
+	}
+
+	return ClosestMantlePoint;
+}
+
+void AMantlePointsActor::BakeMantlePoints()
+{
+	if (!IsValid(CharacterClass))
+	{
+		UE_LOG(LogMantlePoints, Warning, TEXT("AMantlePointsActor::BakeMantlePoints(): %s, Character class isn't set"), *GetNameSafe(this));
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	const AGCBaseCharacter* CharacterDefaults = CharacterClass->GetDefaultObject<AGCBaseCharacter>();
+	const ULedgeDetectorComponent* LedgeDetector = CharacterDefaults->GetLedgeDetectorComponent();
+	const UCharacterMovementComponent* MovementComponent = CharacterDefaults->GetCharacterMovement();
+	const float CapsuleRadius = CharacterDefaults->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	const float CapsuleHalfHeight = CharacterDefaults->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+	Modify();
+	MantlePoints.Reset();
+	Cells.Reset();
+	BakedCapsuleHalfHeight = CapsuleHalfHeight;
+	BakedCellSize = CellSize;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BakeMantlePoints), true, this);
+	const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(CapsuleRadius, CapsuleHalfHeight);
+	const float FloorOffset = 2.0f;
+
+	TMap<FIntPoint, TArray<FMantlePoint>> CellMantlePoints;
+	const FBox Bounds = BakeVolume->Bounds.GetBox();
+	for (float X = Bounds.Min.X; X <= Bounds.Max.X; X += SampleSpacing)
+	{
+		for (float Y = Bounds.Min.Y; Y <= Bounds.Max.Y; Y += SampleSpacing)
+		{
+			// Every walkable floor under the sample is a location the character can stand at.
+			FVector FloorTraceStart(X, Y, Bounds.Max.Z);
+			const FVector FloorTraceEnd(X, Y, Bounds.Min.Z);
+			for (int32 Floor = 0; Floor < MaxFloorsCount; ++Floor)
+			{
+				FHitResult FloorHitResult;
+				if (!World->LineTraceSingleByChannel(FloorHitResult, FloorTraceStart, FloorTraceEnd, ECC_Visibility, QueryParams))
+				{
+					break;
+				}
+				FloorTraceStart = FloorHitResult.ImpactPoint - 2.0f * CapsuleHalfHeight * FVector::UpVector;
+
+				const FVector Location = FloorHitResult.ImpactPoint + (CapsuleHalfHeight + FloorOffset) * FVector::UpVector;
+				if (!MovementComponent->IsWalkable(FloorHitResult)
+					|| World->OverlapBlockingTestByProfile(Location, FQuat::Identity, CollisionProfilePawn, CapsuleShape, QueryParams))
+				{
+					continue;
+				}
+
+				for (int32 i = 0; i < SampleDirectionsCount; ++i)
+				{
+					FRotator Rotation(0.0f, 360.0f * i / SampleDirectionsCount, 0.0f);
+					FMantlePoint MantlePoint;
+					if (!LedgeDetector->ProbeLedge(World, Location, Rotation, CapsuleRadius, CapsuleHalfHeight, MantlePoint.Ledge))
+					{
+						continue;
+					}
+
+					MantlePoint.StartLocation = Location;
+					MantlePoint.HeightClass = MantlePoint.Ledge.Location.Z - Location.Z > CharacterDefaults->GetLowMantleMaxHeight() ? EMantleHeightClass::High : EMantleHeightClass::Low;
+
+					// Neighbour samples and directions find the same ledge, only one point is kept for it.
+					const FIntPoint Cell = GetCell(Location);
+					bool bIsMerged = false;
+					for (int32 CellX = Cell.X - 1; CellX <= Cell.X + 1 && !bIsMerged; ++CellX)
+					{
+						for (int32 CellY = Cell.Y - 1; CellY <= Cell.Y + 1 && !bIsMerged; ++CellY)
+						{
+							const TArray<FMantlePoint>* NeighbourMantlePoints = CellMantlePoints.Find(FIntPoint(CellX, CellY));
+							bIsMerged = NeighbourMantlePoints != nullptr && NeighbourMantlePoints->ContainsByPredicate([&](const FMantlePoint& Other)
+							{
+								return FVector::DistSquared(Other.StartLocation, MantlePoint.StartLocation) < FMath::Square(MergeDistance)
+									&& FVector::DotProduct(Other.Ledge.LedgeNormal, MantlePoint.Ledge.LedgeNormal) > 0.9f;
+							});
+						}
+					}
+
+					if (!bIsMerged)
+					{
+						CellMantlePoints.FindOrAdd(Cell).Add(MantlePoint);
+					}
+				}
+			}
+		}
+	}
+
+	// Points of one cell are stored next to each other, cells keep ranges of the points.
+	CellMantlePoints.KeySort([](const FIntPoint& A, const FIntPoint& B) { return A.X != B.X ? A.X < B.X : A.Y < B.Y; });
+	for (const TPair<FIntPoint, TArray<FMantlePoint>>& CellPoints : CellMantlePoints)
+	{
+		FMantlePointCell& Cell = Cells.Add(CellPoints.Key);
+		Cell.FirstIndex = MantlePoints.Num();
+		Cell.Count = CellPoints.Value.Num();
+		MantlePoints.Append(CellPoints.Value);
+	}
+
+	FNavigationSystem::UpdateActorAndComponentData(*this);
+
+	UE_LOG(LogMantlePoints, Log, TEXT("AMantlePointsActor::BakeMantlePoints(): %s, Baked %i mantle points in %i cells"), *GetNameSafe(this), MantlePoints.Num(), Cells.Num());
+}
+
+void AMantlePointsActor::ClearMantlePoints()
+{
+	Modify();
+	MantlePoints.Empty();
+	Cells.Empty();
+
+	FNavigationSystem::UpdateActorAndComponentData(*this);
+}
+
+FIntPoint AMantlePointsActor::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / BakedCellSize), FMath::FloorToInt(Location.Y / BakedCellSize));
+}
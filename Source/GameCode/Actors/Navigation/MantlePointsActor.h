@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "AI/Navigation/NavRelevantInterface.h"
+#include "Components/LedgeDetectorComponent.h"
+#include "MantlePointsActor.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogMantlePoints, Log, All);
+
+class UBoxComponent;
+class AGCBaseCharacter;
+
+UENUM(BlueprintType)
+enum class EMantleHeightClass : uint8
+{
+	Low,
+	High
+};
+
+USTRUCT(BlueprintType)
+struct FMantlePoint
+{
+	GENERATED_BODY()
+
+	/** Character location the mantle starts from */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Mantle point")
+	FVector StartLocation = FVector::ZeroVector;
+
+	/** Landing location and facing of the mantle */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Mantle point")
+	FLedgeDescription Ledge;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Mantle point")
+	EMantleHeightClass HeightClass = EMantleHeightClass::Low;
+};
+
+/** Range of baked mantle points in one cell of the spatial index */
+USTRUCT()
+struct FMantlePointCell
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 FirstIndex = 0;
+
+	UPROPERTY()
+	int32 Count = 0;
+};
+
+/**
+ * Mantle points baked in the editor from climbing geometry inside the volume for one character class.
+ * Points are saved with the level, runtime mantling uses them instead of probing, AI uses them as nav links.
+ */
+UCLASS()
+class GAMECODE_API AMantlePointsActor : public AActor, public INavRelevantInterface
+{
+	GENERATED_BODY()
+
+public:
+	AMantlePointsActor();
+
+	virtual void GetNavigationData(FNavigationRelevantData& Data) const override;
+	virtual FBox GetNavigationBounds() const override;
+	virtual bool IsNavigationRelevant() const override;
+
+	TSubclassOf<AGCBaseCharacter> GetCharacterClass() const;
+
+	/** Closest point which starts within @MaxDistance of @Location and faces within @MaxYawDelta of @Yaw */
+	const FMantlePoint* FindMantlePoint(const FVector& Location, float Yaw, float MaxDistance, float MaxYawDelta, float& OutDistanceSquared) const;
+
+	/** Scans climbing geometry inside the volume and replaces baked points */
+	UFUNCTION(CallInEditor, Category = "Mantle points")
+	void BakeMantlePoints();
+
+	UFUNCTION(CallInEditor, Category = "Mantle points")
+	void ClearMantlePoints();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UBoxComponent* BakeVolume;
+
+	/** Ledge detector and capsule of this class are used to bake points, only characters of this class use them */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mantle points | Bake")
+	TSubclassOf<AGCBaseCharacter> CharacterClass;
+
+	/** Distance between sampled character locations */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mantle points | Bake", meta = (UIMin = 10.0f, ClampMin = 10.0f))
+	float SampleSpacing = 50.0f;
+
+	/** Number of facings probed from every sampled location */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mantle points | Bake", meta = (UIMin = 1, ClampMin = 1))
+	int32 SampleDirectionsCount = 8;
+
+	/** Max number of floors under one sampled location */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mantle points | Bake", meta = (UIMin = 1, ClampMin = 1))
+	int32 MaxFloorsCount = 4;
+
+	/** Points closer than this to an already baked point with the same facing are dropped */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mantle points | Bake", meta = (UIMin = 0.0f, ClampMin = 0.0f))
+	float MergeDistance = 50.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mantle points | Bake", meta = (UIMin = 100.0f, ClampMin = 100.0f))
+	float CellSize = 500.0f;
+
+	/** Add one way nav links from start to landing location of every point */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Mantle points | Navigation")
+	bool bCreateNavLinks = true;
+
+	UPROPERTY(VisibleAnywhere, Category = "Mantle points | Baked")
+	TArray<FMantlePoint> MantlePoints;
+
+	/** Points are sorted by cells, every cell keeps its range in @MantlePoints */
+	UPROPERTY()
+	TMap<FIntPoint, FMantlePointCell> Cells;
+
+	/** Half height of the capsule points were baked with, nav links connect capsule bottoms */
+	UPROPERTY()
+	float BakedCapsuleHalfHeight = 0.0f;
+
+	/** Cell size of the baked index, @CellSize is applied on the next bake */
+	UPROPERTY()
+	float BakedCellSize = 500.0f;
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+
+};
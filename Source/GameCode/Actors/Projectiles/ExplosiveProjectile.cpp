@@ -3,6 +3,7 @@
 
 #include "ExplosiveProjectile.h"
 #include "Components/ExplosionComponent.h"
+#include "Subsystems/ProjectilePool/ProjectilePoolSubsystem.h"
 
 AExplosiveProjectile::AExplosiveProjectile()
 {
@@ -20,10 +21,28 @@ void AExplosiveProjectile::OnProjectileLaunched()
 
 }
 
+void AExplosiveProjectile::SetProjectileActive_Implementation(bool bIsProjectileActive)
+{
+	Super::SetProjectileActive_Implementation(bIsProjectileActive);
+
+	// Projectile returned to the pool must not explode.
+	if (!bIsProjectileActive)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(DitonationTimer);
+	}
+
+}
+
 void AExplosiveProjectile::OnDetonationTimerElapsed()
 {
 	ExlosionComponent->Explode(GetController());
 
+	// Explosion handlers can destroy the projectile.
+	if (!IsPendingKill())
+	{
+		GetWorld()->GetSubsystem<UProjectilePoolSubsystem>()->ReleaseProjectile(this);
+	}
+
 }
 
 AController* AExplosiveProjectile::GetController()
@@ -26,6 +26,7 @@ protected:
 	float DetonationTime = 2.0f;
 
 	virtual void OnProjectileLaunched() override;
+	virtual void SetProjectileActive_Implementation(bool bIsProjectileActive) override;
 
 private:
 	void OnDetonationTimerElapsed();
@@ -24,6 +24,9 @@ AGCProjectile::AGCProjectile()
 void AGCProjectile::LaunchProjectile(FVector Direction)
 {
     ProjectileMovementComponent->Velocity = Direction * ProjectileMovementComponent->InitialSpeed;
+
+    // Pooled projectile can be reused by another shooter, so earlier owners must not be ignored anymore.
+    CollisionComponent->ClearMoveIgnoreActors();
     CollisionComponent->IgnoreActorWhenMoving(GetOwner(), true);
 
     OnProjectileLaunched();
@@ -4,28 +4,28 @@
 #include "ExplosionComponent.h"
 #include <Kismet/GameplayStatics.h>
 #include <Particles/ParticleSystem.h>
+#include "Subsystems/Explosion/ExplosionSubsystem.h"
 
 
 void UExplosionComponent::Explode(AController* Controller)
 {
-	TArray<AActor*> IgnoredActors;
-	IgnoredActors.Add(GetOwner());
-
-	UGameplayStatics::ApplyRadialDamageWithFalloff(
-		GetWorld(),
-		MaxDamage,
-		MinDamage,
-		GetComponentLocation(),
-		InnerRadius,
-		OuterRadius,
-		DamageFalloff,
-		DamageTypeClass,
-		IgnoredActors,
-		GetOwner(),
-		Controller,
-		ECC_Visibility
-		);
-
+	// Damage is applied by the server only, in one of the next frames.
+	if (GetOwner()->HasAuthority())
+	{
+		FExplosionParams ExplosionParams;
+		ExplosionParams.Origin = GetComponentLocation();
+		ExplosionParams.MaxDamage = MaxDamage;
+		ExplosionParams.MinDamage = MinDamage;
+		ExplosionParams.InnerRadius = InnerRadius;
+		ExplosionParams.OuterRadius = OuterRadius;
+		ExplosionParams.DamageFalloff = DamageFalloff;
+		ExplosionParams.DamageTypeClass = DamageTypeClass;
+		ExplosionParams.IgnoredActor = GetOwner();
+		ExplosionParams.DamageCauser = GetOwner();
+		ExplosionParams.InstigatorController = Controller;
+
+		GetWorld()->GetSubsystem<UExplosionSubsystem>()->QueueExplosion(ExplosionParams);
+	}
 
 
 	if (IsValid(ExplosionVFX))
@@ -2,6 +2,7 @@
 #include "LedgeDetectorComponent.h"
 #include <GameFramework/Character.h>
 #include <Components/CapsuleComponent.h>
+#include "GameFramework/CharacterMovementComponent.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
 #include "../GameCodeTypes.h"
@@ -9,84 +10,375 @@
 #include "../Pawns/Character/GCBaseCharacter.h"
 #include "../GCGameInstance.h"
 #include "../Subsystems/DebugSubsystem.h"
+#include "Subsystems/MantlePoints/MantlePointsSubsystem.h"
+#include "Actors/Navigation/MantlePointsActor.h"
 
 
 
+ULedgeDetectorComponent::ULedgeDetectorComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
 void ULedgeDetectorComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
 	checkf(GetOwner()->IsA<ACharacter>(), TEXT("ULedgeDetectorComponent::BeginPlay only a character can use ULedgeDetectorComponent"));
 	CachedCharacterOwner = StaticCast<ACharacter*>(GetOwner());
+
+#if ENABLE_DRAW_DEBUG
+	CachedDebugSubsystem = UGameplayStatics::GetGameInstance(GetWorld())->GetSubsystem<UDebugSubsystem>();
+#endif
+
+	// Probe runs after the owner moved, so the cached result matches the location input and AI see in the next frame.
+	AddTickPrerequisiteComponent(CachedCharacterOwner->GetCharacterMovement());
+
+	SetContinuousProbeEnabled(bUseContinuousProbe);
+}
+
+void ULedgeDetectorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!bIsProbeActive)
+	{
+		// Interval is kept even if the cache is invalid, detection probes synchronously then.
+		TimeToNextProbe -= DeltaTime;
+		if (TimeToNextProbe > 0.0f)
+		{
+			return;
+		}
+
+		// Owner keeps moving while the stages run, so the probe starts from where it will be when the probe is completed.
+		const float PredictionTime = ((int32)ELedgeProbeStage::Max - 1) * DeltaTime;
+		StartProbe(ActiveProbe, PredictionTime);
+		bIsProbeActive = true;
+	}
+
+	// One stage of the probe per frame
+	FLedgeDescription LedgeDescription;
+	switch (ActiveProbe.Stage)
+	{
+		case ELedgeProbeStage::Forward:
+		{
+			if (ForwardCheck(ActiveProbe))
+			{
+				ActiveProbe.Stage = ELedgeProbeStage::Downward;
+				return;
+			}
+			break;
+		}
+		case ELedgeProbeStage::Downward:
+		{
+			if (DownwardCheck(ActiveProbe))
+			{
+				ActiveProbe.Stage = ELedgeProbeStage::Overlap;
+				return;
+			}
+			break;
+		}
+		case ELedgeProbeStage::Overlap:
+		{
+			if (OverlapCheck(ActiveProbe, LedgeDescription))
+			{
+				CacheProbeResult(ActiveProbe, true, LedgeDescription);
+				bIsProbeActive = false;
+				TimeToNextProbe = ProbeInterval;
+				return;
+			}
+			break;
+		}
+		default:
+			break;
+	}
+
+	CacheProbeResult(ActiveProbe, false, LedgeDescription);
+	bIsProbeActive = false;
+	TimeToNextProbe = ProbeInterval;
 }
 
 bool ULedgeDetectorComponent::DetectLedge(OUT FLedgeDescription& LedgeDescription)
+{
+	if (bUseBakedMantlePoints && DetectBakedLedge(LedgeDescription))
+	{
+		return true;
+	}
+
+	if (bUseContinuousProbe && IsCachedProbeValid())
+	{
+		if (!bHasCachedLedge)
+		{
+			return false;
+		}
+
+		// Dynamic objects could block the landing location since the probe.
+		FLedgeProbe Probe;
+		StartProbe(Probe);
+		if (!IsLedgeLocationBlocked(Probe, CachedLedgeDescription.Location))
+		{
+			LedgeDescription = CachedLedgeDescription;
+			return true;
+		}
+	}
+
+	return RunProbe(LedgeDescription);
+}
+
+bool ULedgeDetectorComponent::IsLedgeAvailable() const
+{
+	return bUseContinuousProbe && bHasCachedLedge && IsCachedProbeValid();
+}
+
+void ULedgeDetectorComponent::SetContinuousProbeEnabled(bool bIsEnabled)
+{
+	bUseContinuousProbe = bIsEnabled;
+	UpdateProbeTickEnabled();
+
+	bIsProbeActive = false;
+	TimeToNextProbe = FMath::FRandRange(0.0f, ProbeInterval);
+	InvalidateLedge();
+}
+
+void ULedgeDetectorComponent::UpdateProbeTickEnabled()
+{
+	SetComponentTickEnabled(bUseContinuousProbe && CachedCharacterOwner.IsValid() && CachedCharacterOwner->GetLocalRole() != ROLE_SimulatedProxy);
+}
+
+void ULedgeDetectorComponent::InvalidateLedge()
+{
+	bIsCacheValid = false;
+	bHasCachedLedge = false;
+	CachedLedgeComponent.Reset();
+}
+
+bool ULedgeDetectorComponent::FindBakedMantlePoint(FMantlePoint& OutMantlePoint) const
+{
+	UMantlePointsSubsystem* MantlePointsSubsystem = GetWorld()->GetSubsystem<UMantlePointsSubsystem>();
+	return IsValid(MantlePointsSubsystem) && MantlePointsSubsystem->FindMantlePoint(CachedCharacterOwner.Get(), BakedPointMaxDistance, BakedPointMaxYaw, OutMantlePoint);
+}
+
+bool ULedgeDetectorComponent::ProbeLedge(UWorld* World, const FVector& Location, const FRotator& Rotation, float CapsuleRadius, float CapsuleHalfHeight, FLedgeDescription& LedgeDescription) const
+{
+	float BotoomZOffset = 2.0f;
+
+	FLedgeProbe Probe;
+	Probe.World = World;
+	Probe.CapsuleRadius = CapsuleRadius;
+	Probe.CapsuleHalfHeight = CapsuleHalfHeight;
+	Probe.OwnerLocation = Location;
+	Probe.OwnerRotation = Rotation;
+	Probe.CharacterBottom = Location - (CapsuleHalfHeight - BotoomZOffset) * FVector::UpVector;
+
+	return ForwardCheck(Probe) && DownwardCheck(Probe) && OverlapCheck(Probe, LedgeDescription);
+}
+
+void ULedgeDetectorComponent::StartProbe(FLedgeProbe& Probe, float PredictionTime) const
 {
 	UCapsuleComponent* CapsuleComponent = CachedCharacterOwner->GetCapsuleComponent();
-	
+
+	float BotoomZOffset = 2.0f;
+
+	Probe.Stage = ELedgeProbeStage::Forward;
+	Probe.World = GetWorld();
+	Probe.IgnoredActor = GetOwner();
+	Probe.CapsuleRadius = CapsuleComponent->GetScaledCapsuleRadius();
+	Probe.CapsuleHalfHeight = CapsuleComponent->GetScaledCapsuleHalfHeight();
+	Probe.OwnerLocation = CachedCharacterOwner->GetActorLocation() + CachedCharacterOwner->GetVelocity() * PredictionTime;
+	Probe.OwnerRotation = CachedCharacterOwner->GetActorRotation();
+	Probe.CharacterBottom = Probe.OwnerLocation - (Probe.CapsuleHalfHeight - BotoomZOffset) * FVector::UpVector;
+}
+
+bool ULedgeDetectorComponent::ForwardCheck(FLedgeProbe& Probe) const
+{
 	FCollisionQueryParams QueryParams;
-	QueryParams.bTraceComplex =true;
-	QueryParams.AddIgnoredActor(GetOwner());
+	QueryParams.bTraceComplex = true;
+	QueryParams.AddIgnoredActor(Probe.IgnoredActor);
 
-#if ENABLE_DRAW_DEBUG
-	UDebugSubsystem* DebugSubSystem = UGameplayStatics::GetGameInstance(GetWorld())->GetSubsystem<UDebugSubsystem>();
-	bool bIsDebugEnabled = DebugSubSystem->IsCategoryEnabled(DebugCategoryLedgeDetection);
-#else
-	bool bIsDebugEnabled = false;
-#endif
+	float DrawTime = 2.0f;
+
+	float ForwardCheckCapsuleRadius = Probe.CapsuleRadius;
+	float ForwardCheckCapsuleHalfheight = (MaximumLedgeHeight - MinimumLedgeHeight) * 0.5f;
+
+	FVector ForwardStartLocation = Probe.CharacterBottom + (MinimumLedgeHeight + ForwardCheckCapsuleHalfheight) * FVector::UpVector;
+	FVector ForwardEndLocation = ForwardStartLocation + Probe.OwnerRotation.Vector() * ForwardCheckDistance;
+
+	return GCTraceUtils::SweepCapsuleSingleByChanel(Probe.World, Probe.ForwardCheckHitResult, ForwardStartLocation, ForwardEndLocation, ForwardCheckCapsuleRadius, ForwardCheckCapsuleHalfheight, FQuat::Identity, ECC_Climbing, QueryParams, FCollisionResponseParams::DefaultResponseParam, IsDebugEnabled(), DrawTime);
+}
+
+bool ULedgeDetectorComponent::DownwardCheck(FLedgeProbe& Probe) const
+{
+	FCollisionQueryParams QueryParams;
+	QueryParams.bTraceComplex = true;
+	QueryParams.AddIgnoredActor(Probe.IgnoredActor);
+
+	float DrawTime = 2.0f;
+
+	float DownwardSphereCheckRadius = Probe.CapsuleRadius;
+
+	float DownwardCheckDepthOffset = 10.0f;
+
+	FVector DownwardStartLocation = Probe.ForwardCheckHitResult.ImpactPoint - Probe.ForwardCheckHitResult.ImpactNormal * DownwardCheckDepthOffset;
+	DownwardStartLocation.Z = Probe.CharacterBottom.Z + MaximumLedgeHeight + DownwardSphereCheckRadius;
+
+	FVector DownwardEndLocation(DownwardStartLocation.X, DownwardStartLocation.Y, Probe.CharacterBottom.Z);
+
+	return GCTraceUtils::SweepSphereSingleByChanel(Probe.World, Probe.DownwardCheckHitResult, DownwardStartLocation, DownwardEndLocation, DownwardSphereCheckRadius, ECC_Climbing, QueryParams, FCollisionResponseParams::DefaultResponseParam, IsDebugEnabled(), DrawTime);
+}
+
+bool ULedgeDetectorComponent::OverlapCheck(const FLedgeProbe& Probe, FLedgeDescription& LedgeDescription) const
+{
+	float OverlapCapsuleFloorOffset = 2.0f;
+
+	FVector OverlapLocation = Probe.DownwardCheckHitResult.ImpactPoint + (Probe.CapsuleHalfHeight + OverlapCapsuleFloorOffset) * FVector::UpVector;
+
+	if (IsLedgeLocationBlocked(Probe, OverlapLocation))
+	{
+		return false;
+	}
+
+	LedgeDescription.Location = OverlapLocation;
+	LedgeDescription.Rotation = (Probe.ForwardCheckHitResult.ImpactNormal * FVector(-1.0f, -1.0f, 0.0f)).ToOrientationRotator();
+	LedgeDescription.LedgeNormal = Probe.ForwardCheckHitResult.ImpactNormal;
+
+	return true;
+}
+
+bool ULedgeDetectorComponent::IsLedgeLocationBlocked(const FLedgeProbe& Probe, const FVector& Location) const
+{
+	FCollisionQueryParams QueryParams;
+	QueryParams.bTraceComplex = true;
+	QueryParams.AddIgnoredActor(Probe.IgnoredActor);
 
 	float DrawTime = 2.0f;
 
-	float BotoomZOffset = 2.0f;
-	FVector CharacterBottom = CachedCharacterOwner->GetActorLocation() - (CapsuleComponent->GetScaledCapsuleHalfHeight() - BotoomZOffset) * FVector::UpVector;
-	
-	
-	//1. Forward check
-	float ForwardCheckCapsuleRadius = CapsuleComponent->GetScaledCapsuleRadius();
 	float ForwardCheckCapsuleHalfheight = (MaximumLedgeHeight - MinimumLedgeHeight) * 0.5f;
 
-	FHitResult ForwardCheckHitResult;
-	FVector ForwardStartLocation = CharacterBottom + (MinimumLedgeHeight + ForwardCheckCapsuleHalfheight) * FVector::UpVector;
-	FVector ForwardEndLocation = ForwardStartLocation + CachedCharacterOwner->GetActorForwardVector() * ForwardCheckDistance;
+	return GCTraceUtils::OverlapCapsuleBlockingByProfile(Probe.World, Location, Probe.CapsuleRadius, ForwardCheckCapsuleHalfheight, FQuat::Identity, CollisionProfilePawn, QueryParams, IsDebugEnabled(), DrawTime);
+}
+
+bool ULedgeDetectorComponent::RunProbe(FLedgeDescription& LedgeDescription)
+{
+	FLedgeProbe Probe;
+	StartProbe(Probe);
+
+	bool bHasLedge = ForwardCheck(Probe) && DownwardCheck(Probe) && OverlapCheck(Probe, LedgeDescription);
+	CacheProbeResult(Probe, bHasLedge, LedgeDescription);
 
-	if (!GCTraceUtils::SweepCapsuleSingleByChanel(GetWorld(),ForwardCheckHitResult, ForwardStartLocation, ForwardEndLocation, ForwardCheckCapsuleRadius, ForwardCheckCapsuleHalfheight, FQuat::Identity, ECC_Climbing, QueryParams, FCollisionResponseParams::DefaultResponseParam, bIsDebugEnabled, DrawTime))
+	return bHasLedge;
+}
+
+bool ULedgeDetectorComponent::DetectBakedLedge(FLedgeDescription& LedgeDescription)
+{
+	FMantlePoint MantlePoint;
+	if (!FindBakedMantlePoint(MantlePoint))
 	{
 		return false;
 	}
 
-	//2. Downward check
-	FHitResult DownwardCheckHitResult;
+	// Point is found by distance to its start, the owner can stand beside or behind it.
+	FLedgeProbe Probe;
+	StartProbe(Probe);
+	if (!IsLedgeInReach(Probe, MantlePoint.Ledge))
+	{
+		return false;
+	}
 
-	float DownwardSphereCheckRadius = CapsuleComponent->GetScaledCapsuleRadius();
+	// Baked points don't know about dynamic objects, so the landing location is checked too.
+	if (IsLedgeLocationBlocked(Probe, MantlePoint.Ledge.Location))
+	{
+		return false;
+	}
 
+	LedgeDescription = MantlePoint.Ledge;
+	return true;
+}
+
+bool ULedgeDetectorComponent::IsLedgeInReach(const FLedgeProbe& Probe, const FLedgeDescription& LedgeDescription) const
+{
+	float OverlapCapsuleFloorOffset = 2.0f;
 	float DownwardCheckDepthOffset = 10.0f;
-	
-	FVector DownwardStartLocation = ForwardCheckHitResult.ImpactPoint - ForwardCheckHitResult.ImpactNormal * DownwardCheckDepthOffset;
-	DownwardStartLocation.Z = CharacterBottom.Z + MaximumLedgeHeight + DownwardSphereCheckRadius;
 
-	FVector DownwardEndLocation(DownwardStartLocation.X, DownwardStartLocation.Y, CharacterBottom.Z);
+	float LedgeHeight = LedgeDescription.Location.Z - Probe.CapsuleHalfHeight - OverlapCapsuleFloorOffset - Probe.CharacterBottom.Z;
+	if (LedgeHeight < MinimumLedgeHeight || LedgeHeight > MaximumLedgeHeight)
+	{
+		return false;
+	}
+
+	// Forward check sweeps a capsule of the owner radius along the facing, so the ledge must be straight ahead.
+	const FVector Forward = Probe.OwnerRotation.Vector().GetSafeNormal2D();
+	const FVector ToLedge = (LedgeDescription.Location - Probe.OwnerLocation) * FVector(1.0f, 1.0f, 0.0f);
+	float ForwardDistance = FVector::DotProduct(ToLedge, Forward);
+	float SideDistance = (ToLedge - ForwardDistance * Forward).Size();
 
-	if (!GCTraceUtils::SweepSphereSingleByChanel(GetWorld(), DownwardCheckHitResult, DownwardStartLocation, DownwardEndLocation, DownwardSphereCheckRadius, ECC_Climbing, QueryParams, FCollisionResponseParams::DefaultResponseParam, bIsDebugEnabled, DrawTime))
+	return ForwardDistance > 0.0f
+		&& ForwardDistance <= ForwardCheckDistance + Probe.CapsuleRadius + DownwardCheckDepthOffset
+		&& SideDistance <= Probe.CapsuleRadius;
+}
+
+void ULedgeDetectorComponent::CacheProbeResult(const FLedgeProbe& Probe, bool bHasLedge, const FLedgeDescription& LedgeDescription)
+{
+	bIsCacheValid = true;
+	bHasCachedLedge = bHasLedge;
+	CachedOwnerLocation = Probe.OwnerLocation;
+	CachedOwnerYaw = Probe.OwnerRotation.Yaw;
+
+	if (bHasLedge)
+	{
+		CachedLedgeDescription = LedgeDescription;
+		CachedLedgeComponent = Probe.DownwardCheckHitResult.GetComponent();
+		if (CachedLedgeComponent.IsValid())
+		{
+			CachedLedgeComponentTransform = CachedLedgeComponent->GetComponentTransform();
+		}
+	}
+	else
+	{
+		CachedLedgeComponent.Reset();
+	}
+}
+
+bool ULedgeDetectorComponent::IsCachedProbeValid() const
+{
+	if (!bIsCacheValid)
 	{
 		return false;
 	}
 
-	//3. Overlap check
-	float OverlapCapsuleRadius = CapsuleComponent->GetScaledCapsuleRadius();
-	float OverlapCapsuleHalfHeight = CapsuleComponent->GetScaledCapsuleHalfHeight();
-	
-	float OverlapCapsuleFloorOffset = 2.0f;
-	
-	FVector OverlapLocation = DownwardCheckHitResult.ImpactPoint + (OverlapCapsuleHalfHeight + OverlapCapsuleFloorOffset) * FVector::UpVector;
+	if (bHasCachedLedge)
+	{
+		// Ledge is gone if the component it is on was destroyed or moved.
+		if (!CachedLedgeComponent.IsValid() || !CachedLedgeComponent->GetComponentTransform().Equals(CachedLedgeComponentTransform))
+		{
+			return false;
+		}
 
-	if (GCTraceUtils::OverlapCapsuleBlockingByProfile(GetWorld(), OverlapLocation, ForwardCheckCapsuleRadius, ForwardCheckCapsuleHalfheight, FQuat::Identity, CollisionProfilePawn, QueryParams, bIsDebugEnabled, DrawTime))
+		// Cached ledge is kept while the owner moves, as long as the probe from the current location would find it.
+		FLedgeProbe Probe;
+		StartProbe(Probe);
+		return IsLedgeInReach(Probe, CachedLedgeDescription);
+	}
+
+	// Ledge could appear in front of the owner once it moved or turned.
+	if (FVector::DistSquared(CachedCharacterOwner->GetActorLocation(), CachedOwnerLocation) > FMath::Square(InvalidationDistance))
 	{
 		return false;
 	}
 
-	LedgeDescription.Location = OverlapLocation;
-	LedgeDescription.Rotation = (ForwardCheckHitResult.ImpactNormal * FVector(-1.0f, -1.0f, 0.0f)).ToOrientationRotator();
-	LedgeDescription.LedgeNormal = ForwardCheckHitResult.ImpactNormal;
+	if (FMath::Abs(FRotator::NormalizeAxis(CachedCharacterOwner->GetActorRotation().Yaw - CachedOwnerYaw)) > InvalidationYaw)
+	{
+		return false;
+	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+bool ULedgeDetectorComponent::IsDebugEnabled() const
+{
+#if ENABLE_DRAW_DEBUG
+	return CachedDebugSubsystem.IsValid() && CachedDebugSubsystem->IsCategoryEnabled(DebugCategoryLedgeDetection);
+#else
+	return false;
+#endif
+}
@@ -6,6 +6,8 @@
 #include "Components/ActorComponent.h"
 #include "LedgeDetectorComponent.generated.h"
 
+struct FMantlePoint;
+
 USTRUCT(BlueprintType)
 struct FLedgeDescription
 {
@@ -22,14 +24,65 @@ struct FLedgeDescription
 
 };
 
+enum class ELedgeProbeStage : uint8
+{
+	Forward,
+	Downward,
+	Overlap,
+	Max
+};
+
+/** Ledge probe of one owner transform, its stages can be run in one call or one per frame */
+struct FLedgeProbe
+{
+	ELedgeProbeStage Stage = ELedgeProbeStage::Forward;
+
+	UWorld* World = nullptr;
+	const AActor* IgnoredActor = nullptr;
+	float CapsuleRadius = 0.0f;
+	float CapsuleHalfHeight = 0.0f;
+
+	FVector OwnerLocation = FVector::ZeroVector;
+	FRotator OwnerRotation = FRotator::ZeroRotator;
+	FVector CharacterBottom = FVector::ZeroVector;
+
+	FHitResult ForwardCheckHitResult;
+	FHitResult DownwardCheckHitResult;
+};
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class GAMECODE_API ULedgeDetectorComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
 public:	
+	ULedgeDetectorComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Returns cached ledge if continuous probe has a valid one, otherwise probes the ledge immediately */
 	bool DetectLedge(OUT FLedgeDescription& LedgeDescription);
 
+	/** Cheap check of the last continuous probe result, always false if continuous probe is disabled */
+	UFUNCTION(BlueprintCallable, Category = "Ledge detection")
+	bool IsLedgeAvailable() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Ledge detection")
+	void SetContinuousProbeEnabled(bool bIsEnabled);
+
+	/** Simulated proxies mantle only when it is replicated, so the continuous probe ticks on other roles only */
+	void UpdateProbeTickEnabled();
+
+	/** Drops cached probe result, next detection probes the ledge again */
+	UFUNCTION(BlueprintCallable, Category = "Ledge detection")
+	void InvalidateLedge();
+
+	/** Baked mantle point the owner can use from its current location */
+	bool FindBakedMantlePoint(FMantlePoint& OutMantlePoint) const;
+
+	/** Probes ledge of a capsule at @Location in @World with settings of this detector, used to bake mantle points */
+	bool ProbeLedge(UWorld* World, const FVector& Location, const FRotator& Rotation, float CapsuleRadius, float CapsuleHalfHeight, FLedgeDescription& LedgeDescription) const;
+
 protected:
 
 	virtual void BeginPlay() override;
@@ -43,8 +96,65 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Detection serring", meta = (UIMin = 0.0f, ClampMin = 0.0f))
 	float ForwardCheckDistance = 100.0f;
 
+	/** Probe ledge in the background one stage per frame, so mantle uses the cached result */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Detection serring | Continuous probe")
+	bool bUseContinuousProbe = false;
+
+	/** Seconds between the end of one continuous probe and the start of the next one. First probe starts at a random time within it, so characters don't probe in the same frames. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Detection serring | Continuous probe", meta = (UIMin = 0.0f, ClampMin = 0.0f))
+	float ProbeInterval = 0.1f;
+
+	/** Cached result without a ledge is invalid after the owner moved further since the probe. Cached ledge stays valid while it is in reach. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Detection serring | Continuous probe", meta = (UIMin = 0.0f, ClampMin = 0.0f))
+	float InvalidationDistance = 10.0f;
+
+	/** Cached result without a ledge is invalid after the owner turned further since the probe, degrees */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Detection serring | Continuous probe", meta = (UIMin = 0.0f, ClampMin = 0.0f))
+	float InvalidationYaw = 5.0f;
+
+	/** Use mantle points baked in the level instead of probing when one is in range */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Detection serring | Baked mantle points")
+	bool bUseBakedMantlePoints = true;
+
+	/** Max distance from the owner to the start location of a baked mantle point */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Detection serring | Baked mantle points", meta = (UIMin = 0.0f, ClampMin = 0.0f))
+	float BakedPointMaxDistance = 50.0f;
+
+	/** Max angle between the owner facing and the facing of a baked mantle point, degrees */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Detection serring | Baked mantle points", meta = (UIMin = 0.0f, ClampMin = 0.0f, UIMax = 180.0f, ClampMax = 180.0f))
+	float BakedPointMaxYaw = 45.0f;
+
 private:
+	/** Owner transform of the probe is predicted @PredictionTime seconds ahead by its velocity */
+	void StartProbe(FLedgeProbe& Probe, float PredictionTime = 0.0f) const;
+	bool ForwardCheck(FLedgeProbe& Probe) const;
+	bool DownwardCheck(FLedgeProbe& Probe) const;
+	bool OverlapCheck(const FLedgeProbe& Probe, FLedgeDescription& LedgeDescription) const;
+	bool IsLedgeLocationBlocked(const FLedgeProbe& Probe, const FVector& Location) const;
+	bool RunProbe(FLedgeDescription& LedgeDescription);
+	bool DetectBakedLedge(FLedgeDescription& LedgeDescription);
+	/** Ledge is in front of the probe capsule within the forward check distance and the ledge height range, as the probe would find it */
+	bool IsLedgeInReach(const FLedgeProbe& Probe, const FLedgeDescription& LedgeDescription) const;
+
+	void CacheProbeResult(const FLedgeProbe& Probe, bool bHasLedge, const FLedgeDescription& LedgeDescription);
+	bool IsCachedProbeValid() const;
+	bool IsDebugEnabled() const;
 
 	TWeakObjectPtr<class ACharacter> CachedCharacterOwner;
+	TWeakObjectPtr<class UDebugSubsystem> CachedDebugSubsystem;
+
+	/** Continuous probe in progress */
+	FLedgeProbe ActiveProbe;
+	bool bIsProbeActive = false;
+	float TimeToNextProbe = 0.0f;
+
+	/** Result of the last completed probe */
+	FLedgeDescription CachedLedgeDescription;
+	FVector CachedOwnerLocation = FVector::ZeroVector;
+	float CachedOwnerYaw = 0.0f;
+	TWeakObjectPtr<UPrimitiveComponent> CachedLedgeComponent;
+	FTransform CachedLedgeComponentTransform;
+	bool bHasCachedLedge = false;
+	bool bIsCacheValid = false;
 		
 };
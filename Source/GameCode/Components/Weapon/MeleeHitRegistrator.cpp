@@ -7,6 +7,7 @@
 #include <Utils/GCTraceUtils.h>
 #include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
+#include "Subsystems/LagCompensation/LagCompensationSubsystem.h"
 
 UMeleeHitRegistrator::UMeleeHitRegistrator()
 {
@@ -42,6 +43,15 @@ void UMeleeHitRegistrator::ProcessHitRegistration()
 	bool bIsDebugEnabled = false;
 #endif
 
+	// Swing of a remote attacker is checked against characters rewound by half of its round trip.
+	const APawn* AttackerPawn = IsValid(GetOwner()) ? Cast<APawn>(GetOwner()->GetOwner()) : nullptr;
+	ULagCompensationSubsystem* LagCompensationSubsystem = nullptr;
+	if (IsValid(AttackerPawn) && AttackerPawn->HasAuthority() && !AttackerPawn->IsLocallyControlled())
+	{
+		LagCompensationSubsystem = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+		LagCompensationSubsystem->RewindCharacters(LagCompensationSubsystem->GetClientViewTime(AttackerPawn), AttackerPawn);
+	}
+
 	bool bHasHit = GCTraceUtils::SweepSphereSingleByChanel(
 			GetWorld(),
 			HitResult,
@@ -55,6 +65,11 @@ void UMeleeHitRegistrator::ProcessHitRegistration()
 			5.0f
 			);
 
+	if (IsValid(LagCompensationSubsystem))
+	{
+		LagCompensationSubsystem->RestoreCharacters();
+	}
+
 	if (bHasHit)
 	{
 		FVector Direction = (CurrentLocation - PreviousComponentLocation).GetSafeNormal();
@@ -6,68 +6,76 @@
 #include "DrawDebugHelpers.h"
 #include <Subsystems/DebugSubsystem.h>
 #include "Kismet/GameplayStatics.h"
-#include "NiagaraFunctionLibrary.h"
-#include "NiagaraComponent.h"
-#include "Components/DecalComponent.h"
 #include "Actors/Projectiles/GCProjectile.h"
 #include "Net/UnrealNetwork.h"
+#include "Subsystems/ProjectilePool/ProjectilePoolSubsystem.h"
+#include "Subsystems/BulletSimulation/BulletSimulationSubsystem.h"
+#include "Subsystems/LagCompensation/LagCompensationSubsystem.h"
+#include "Subsystems/ImpactEffects/ImpactEffectsSubsystem.h"
+#include "Subsystems/DamageFalloff/DamageFalloffSubsystem.h"
+#include "GameFramework/GameStateBase.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
+
+void FShotRequest::Quantize()
+{
+	FBitWriter Writer(0, true);
+	bool bIsSuccess = true;
+	Location_Mul_10.NetSerialize(Writer, nullptr, bIsSuccess);
+	Direction.NetSerialize(Writer, nullptr, bIsSuccess);
+
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	Location_Mul_10.NetSerialize(Reader, nullptr, bIsSuccess);
+	Direction.NetSerialize(Reader, nullptr, bIsSuccess);
+}
 
 
 UWeaponBarellComponent::UWeaponBarellComponent()
 {
 	SetIsReplicatedByDefault(true);
 
+	AsyncHitScanDelegate.BindUObject(this, &UWeaponBarellComponent::OnAsyncHitScanCompleted);
+
 }
 
 void UWeaponBarellComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	FalloffTable = GetWorld()->GetGameInstance()->GetSubsystem<UDamageFalloffSubsystem>()->GetFalloffTable(FalloffDiagrama);
+
 	if (GetOwnerRole() < ROLE_Authority)
 	{
 		return;
 	}
 
-	SaveCurveDamage = DamageAmount;
-
-	if (!IsValid(ProjectileClass))
+	if (HitRegistration != EHitRegistrationType::Projectile || !IsValid(ProjectileClass))
 	{
 		return;
 	}
 
-	ProjectilePool.Reserve(ProjectilePoolSize);
-	for (int32 i = 0; i < ProjectilePoolSize; ++i)
-	{
-		AGCProjectile* Projectile = GetWorld()->SpawnActor<AGCProjectile>(ProjectileClass, ProjectilePoolLocation, FRotator::ZeroRotator);
-		Projectile->SetOwner(GetOwnerPawn());
-		Projectile->SetProjectileActive(false);
-		ProjectilePool.Add(Projectile);
+	GetWorld()->GetSubsystem<UProjectilePoolSubsystem>()->PrewarmPool(ProjectileClass, ProjectilePoolSize);
 
-	}
-
-
-	
 }
 
-void UWeaponBarellComponent::Shot(FVector ShotStart, FVector ShotDirection, float SpreadAngle)
+void UWeaponBarellComponent::Shot(FVector ShotStart, FVector ShotDirection, float SpreadAngle, float ShotTimeOffset)
 {
-	TArray<FShotInfo> ShotInfo;
-	
-	for (int i = 0; i < BulletPerShot; i++)
-	{
-		ShotDirection += GetBulletSpreadOffset(FMath::RandRange(0.0f, SpreadAngle), ShotDirection.ToOrientationRotator());
-		ShotDirection = ShotDirection.GetSafeNormal();
-		
-		ShotInfo.Emplace(ShotStart, ShotDirection);
-	
-	}
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	const float ClientTime = (IsValid(GameState) ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds()) - ShotTimeOffset;
+	FShotRequest ShotRequest(ShotStart, ShotDirection, SpreadAngle, ShotCounter++, FMath::Rand(), ClientTime);
+	ShotRequest.Quantize();
 
 	if (GetOwner()->GetLocalRole() == ROLE_AutonomousProxy)
 	{
-		Server_Shot(ShotInfo);
+		if (PendingShotRequests.Num() == 0)
+		{
+			GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UWeaponBarellComponent::SendPendingShotRequests);
+		}
+
+		PendingShotRequests.Add(ShotRequest);
 	}
-	
-	ShotInternal(ShotInfo);
+
+	ProcessShotRequests({ ShotRequest });
 
 }
 
@@ -80,14 +88,11 @@ void UWeaponBarellComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty
 	RepParams.Condition = COND_SimulatedOnly;
 	RepParams.RepNotifyCondition = REPNOTIFY_Always;
 
-	DOREPLIFETIME_WITH_PARAMS(UWeaponBarellComponent, LastShotsInfo, RepParams);
-	DOREPLIFETIME(UWeaponBarellComponent, ProjectilePool);
-	DOREPLIFETIME(UWeaponBarellComponent, CurrentProjectileIndex);
-	DOREPLIFETIME(UWeaponBarellComponent, SaveCurveDamage);
+	DOREPLIFETIME_WITH_PARAMS(UWeaponBarellComponent, LastShotRequests, RepParams);
 
 }
 
-bool UWeaponBarellComponent::HitScan(FVector ShotStart, OUT FVector& ShotEnd, FVector ShotDirection)
+bool UWeaponBarellComponent::HitScan(FVector ShotStart, OUT FVector& ShotEnd, FVector ShotDirection, const FVector& MuzzleLocation)
 {
 	FHitResult ShotResult;
 	bool bHasHit = GetWorld()->LineTraceSingleByChannel(ShotResult, ShotStart, ShotEnd, ECC_Bullet);
@@ -95,42 +100,189 @@ bool UWeaponBarellComponent::HitScan(FVector ShotStart, OUT FVector& ShotEnd, FV
 	{
 		ShotEnd = ShotResult.ImpactPoint;
 
-		float ForwardDistance = (MuzzleLocation - ShotEnd).Size();
-		if (IsValid(FalloffDiagrama))
+		ApplyDamage(ShotResult.GetActor(), GetHitScanDamage(ShotEnd, MuzzleLocation), ShotResult, ShotDirection);
+		SpawnImpactDecal(ShotResult);
+	}
+
+
+	return bHasHit;
+}
+
+void UWeaponBarellComponent::BatchedHitScan(const TArray<FShotInfo>& ShotsInfo, TArray<FVector>& InOutShotEnds, TBitArray<>& OutHasHits, const FVector& MuzzleLocation)
+{
+	OutHasHits.Init(false, ShotsInfo.Num());
+
+	FBox ShotsBounds(ForceInit);
+	for (int32 i = 0; i < ShotsInfo.Num(); ++i)
+	{
+		ShotsBounds += ShotsInfo[i].GetLocation();
+		ShotsBounds += InOutShotEnds[i];
+	}
+
+	TArray<FOverlapResult> Overlaps;
+	GetWorld()->OverlapMultiByChannel(Overlaps, ShotsBounds.GetCenter(), FQuat::Identity, ECC_Bullet, FCollisionShape::MakeBox(ShotsBounds.GetExtent()));
+
+	TArray<UPrimitiveComponent*> Candidates;
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		// Overlap returns components that overlap bullets too, only blocking ones can be hit.
+		if (Overlap.bBlockingHit && Overlap.Component.IsValid())
 		{
-			float CurveValue = FalloffDiagrama->GetFloatValue(ForwardDistance);
+			Candidates.AddUnique(Overlap.Component.Get());
+		}
+	}
 
-			if (CurveValue > 0.0f && SaveCurveDamage > 0.0f)
-			{
+	const bool bUseCandidates = Candidates.Num() <= MaxBatchedHitScanCandidates;
 
-				DamageAmount = SaveCurveDamage + (CurveValue * SaveCurveDamage);
+	TArray<FHitResult> HitResults;
+	HitResults.SetNum(ShotsInfo.Num());
+	for (int32 i = 0; i < ShotsInfo.Num(); ++i)
+	{
+		const FVector ShotStart = ShotsInfo[i].GetLocation();
+		const bool bHasHit = bUseCandidates
+			? HitScanComponents(Candidates, ShotStart, InOutShotEnds[i], HitResults[i])
+			: GetWorld()->LineTraceSingleByChannel(HitResults[i], ShotStart, InOutShotEnds[i], ECC_Bullet);
 
-			}
+		if (bHasHit)
+		{
+			OutHasHits[i] = true;
+			InOutShotEnds[i] = HitResults[i].ImpactPoint;
+		}
+	}
 
+	ProcessHitScanResults(ShotsInfo, HitResults, OutHasHits, MuzzleLocation);
+}
+
+void UWeaponBarellComponent::ProcessHitScanResults(const TArray<FShotInfo>& ShotsInfo, const TArray<FHitResult>& HitResults, const TBitArray<>& HasHits, const FVector& MuzzleLocation)
+{
+	struct FActorHit
+	{
+		const FHitResult* HitResult = nullptr;
+		FVector Direction = FVector::ZeroVector;
+		float Damage = 0.0f;
+	};
+	TMap<AActor*, FActorHit> ActorHits;
+
+	for (int32 i = 0; i < ShotsInfo.Num(); ++i)
+	{
+		if (!HasHits[i])
+		{
+			continue;
 		}
 
-		ProcessHit(ShotResult, ShotDirection);
+		const FHitResult& ShotResult = HitResults[i];
+		SpawnImpactDecal(ShotResult);
+
+		// Bullets that hit the same actor are applied as one damage event of the first bullet.
+		AActor* HitActor = ShotResult.GetActor();
+		FActorHit* ActorHit = ActorHits.Find(HitActor);
+		if (ActorHit == nullptr)
+		{
+			ActorHit = &ActorHits.Add(HitActor);
+			ActorHit->HitResult = &ShotResult;
+			ActorHit->Direction = ShotsInfo[i].GetDirection();
+		}
+		ActorHit->Damage += GetHitScanDamage(ShotResult.ImpactPoint, MuzzleLocation);
 	}
 
+	for (const TPair<AActor*, FActorHit>& ActorHit : ActorHits)
+	{
+		ApplyDamage(ActorHit.Key, ActorHit.Value.Damage, *ActorHit.Value.HitResult, ActorHit.Value.Direction);
+	}
+}
 
-	return bHasHit;
+void UWeaponBarellComponent::AsyncHitScan(const TArray<FShotInfo>& ShotsInfo, const TArray<FVector>& ShotEnds, bool bIsDebugEnabled, const FVector& MuzzleLocation)
+{
+	const uint32 ShotId = NextAsyncHitScanShotId++;
+	FAsyncHitScanShot& AsyncShot = AsyncHitScanShots.Add(ShotId);
+	AsyncShot.ShotsInfo = ShotsInfo;
+	AsyncShot.ShotEnds = ShotEnds;
+	AsyncShot.HitResults.SetNum(ShotsInfo.Num());
+	AsyncShot.HasHits.Init(false, ShotsInfo.Num());
+	AsyncShot.MuzzleLocation = MuzzleLocation;
+	AsyncShot.MuzzleRotation = GetComponentRotation();
+	AsyncShot.bIsDebugEnabled = bIsDebugEnabled;
+
+	// Traces of this frame are run together on worker threads, results come next frame.
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AsyncHitScan));
+	for (int32 i = 0; i < ShotsInfo.Num(); ++i)
+	{
+		AsyncShot.TraceHandles.Add(GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, ShotsInfo[i].GetLocation(), ShotEnds[i], ECC_Bullet, QueryParams, FCollisionResponseParams::DefaultResponseParam, &AsyncHitScanDelegate, ShotId));
+	}
 }
 
+void UWeaponBarellComponent::OnAsyncHitScanCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FAsyncHitScanShot* AsyncShot = AsyncHitScanShots.Find(TraceDatum.UserData);
+	if (AsyncShot == nullptr)
+	{
+		return;
+	}
 
-void UWeaponBarellComponent::ProcessProjectileHit(AGCProjectile* Projectile, const FHitResult& HitResult, const FVector& Direction)
+	const int32 TraceIndex = AsyncShot->TraceHandles.IndexOfByKey(TraceHandle);
+	if (TraceIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& HitResult) { return HitResult.bBlockingHit; });
+	if (BlockingHit != nullptr)
+	{
+		AsyncShot->HitResults[TraceIndex] = *BlockingHit;
+		AsyncShot->HasHits[TraceIndex] = true;
+		AsyncShot->ShotEnds[TraceIndex] = BlockingHit->ImpactPoint;
+	}
+
+	++AsyncShot->CompletedTraces;
+	if (AsyncShot->CompletedTraces < AsyncShot->TraceHandles.Num())
+	{
+		return;
+	}
+
+	// Damage falloff and trace FX use muzzle of the frame the shot was made in.
+	FAsyncHitScanShot CompletedShot = MoveTemp(*AsyncShot);
+	AsyncHitScanShots.Remove(TraceDatum.UserData);
+
+	ProcessHitScanResults(CompletedShot.ShotsInfo, CompletedShot.HitResults, CompletedShot.HasHits, CompletedShot.MuzzleLocation);
+	SpawnTraceFX(CompletedShot.ShotEnds, CompletedShot.MuzzleLocation, CompletedShot.MuzzleRotation);
+	DrawShotsDebug(CompletedShot.ShotEnds, CompletedShot.HasHits, CompletedShot.MuzzleLocation, CompletedShot.bIsDebugEnabled);
+}
+
+bool UWeaponBarellComponent::HitScanComponents(const TArray<UPrimitiveComponent*>& Components, const FVector& ShotStart, const FVector& ShotEnd, FHitResult& OutHitResult) const
 {
-	Projectile->SetProjectileActive(false);
-	Projectile->SetActorLocation(ProjectilePoolLocation);
-	Projectile->SetActorRotation(FRotator::ZeroRotator);
-	Projectile->OnProjectileHit.RemoveAll(this);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BatchedHitScan));
 
-	ProcessHit(HitResult, Direction);
+	bool bHasHit = false;
+	FHitResult ComponentHitResult;
+	for (UPrimitiveComponent* Component : Components)
+	{
+		if (!IsValid(Component) || !Component->LineTraceComponent(ComponentHitResult, ShotStart, ShotEnd, QueryParams))
+		{
+			continue;
+		}
+
+		if (!bHasHit || ComponentHitResult.Distance < OutHitResult.Distance)
+		{
+			OutHitResult = ComponentHitResult;
+			bHasHit = true;
+		}
+	}
+
+	return bHasHit;
 }
 
-void UWeaponBarellComponent::ProcessHit(const FHitResult& HitResult, const FVector& Direction)
+float UWeaponBarellComponent::GetHitScanDamage(const FVector& ImpactPoint, const FVector& MuzzleLocation) const
+{
+	return GetDamageAtDistance(FVector::Distance(MuzzleLocation, ImpactPoint));
+}
+
+float UWeaponBarellComponent::GetDamageAtDistance(float Distance) const
 {
-	AActor* HitActor = HitResult.GetActor();
+	return FalloffTable.IsValid() ? FalloffTable->GetDamage(DamageAmount, Distance) : DamageAmount;
+}
 
+void UWeaponBarellComponent::ApplyDamage(AActor* HitActor, float Damage, const FHitResult& HitResult, const FVector& Direction)
+{
 	if (GetOwner()->HasAuthority() && IsValid(HitActor))
 	{
 		FPointDamageEvent DamageEvent;
@@ -138,113 +290,254 @@ void UWeaponBarellComponent::ProcessHit(const FHitResult& HitResult, const FVect
 		DamageEvent.ShotDirection = Direction;
 		DamageEvent.DamageTypeClass = DamageTypeClass;
 
-		HitActor->TakeDamage(DamageAmount, DamageEvent, GetController(), GetOwner());
+		HitActor->TakeDamage(Damage, DamageEvent, GetController(), GetOwner());
+	}
+}
 
-		UE_LOG(LogTemp, Warning, TEXT("Damage = %f"), DamageAmount);
+void UWeaponBarellComponent::SpawnImpactDecal(const FHitResult& HitResult)
+{
+	GetWorld()->GetSubsystem<UImpactEffectsSubsystem>()->SpawnDecal(DefaultDecalInfo, HitResult.ImpactPoint, HitResult.ImpactNormal.ToOrientationRotator());
+}
 
+void UWeaponBarellComponent::SpawnTraceFX(const TArray<FVector>& ShotEnds, const FVector& MuzzleLocation, const FRotator& MuzzleRotation)
+{
+	UImpactEffectsSubsystem* ImpactEffectsSubsystem = GetWorld()->GetSubsystem<UImpactEffectsSubsystem>();
+	if (ShotEnds.Num() > 1 && IsValid(MultiTraceFX))
+	{
+		ImpactEffectsSubsystem->SpawnMultiTraceEffect(MultiTraceFX, MuzzleLocation, MuzzleRotation, FXParamTraceEnds, ShotEnds);
+		return;
 	}
 
-	UDecalComponent* DecalComponent = UGameplayStatics::SpawnDecalAtLocation(GetWorld(), DefaultDecalInfo.DecalMaterial, DefaultDecalInfo.DecalSize, HitResult.ImpactPoint, HitResult.ImpactNormal.ToOrientationRotator());
-	if (IsValid(DecalComponent))
+	for (const FVector& ShotEnd : ShotEnds)
 	{
-		DecalComponent->SetFadeScreenSize(0.0001f);
-		DecalComponent->SetFadeOut(DefaultDecalInfo.DecalLifeTime, DefaultDecalInfo.DecalFadeOutTime);
+		ImpactEffectsSubsystem->SpawnTraceEffect(TraceFX, MuzzleLocation, MuzzleRotation, FXParamTraceEnd, ShotEnd);
 	}
 }
 
 
+void UWeaponBarellComponent::ProcessProjectileHit(AGCProjectile* Projectile, const FHitResult& HitResult, const FVector& Direction)
+{
+	Projectile->OnProjectileHit.RemoveAll(this);
+	GetWorld()->GetSubsystem<UProjectilePoolSubsystem>()->ReleaseProjectile(Projectile);
+
+	ProcessHit(HitResult, Direction);
+}
+
+void UWeaponBarellComponent::ProcessHit(const FHitResult& HitResult, const FVector& Direction)
+{
+	ApplyDamage(HitResult.GetActor(), DamageAmount, HitResult, Direction);
+	SpawnImpactDecal(HitResult);
+}
+
+
 void UWeaponBarellComponent::LaunchProjectile(const FVector& LaunchStart, const FVector& LaunchDirection)
 {
-	
-	AGCProjectile* Projectile = ProjectilePool[CurrentProjectileIndex];
-	
-	Projectile->SetActorLocation(LaunchStart);
-	Projectile->SetActorRotation(LaunchDirection.ToOrientationRotator());
+	// Pooled projectiles are replicated, clients see the ones launched by the server.
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
 
-	Projectile->SetProjectileActive(true);
-	Projectile->OnProjectileHit.AddDynamic(this, &UWeaponBarellComponent::ProcessProjectileHit);
-	Projectile->LaunchProjectile(LaunchDirection.GetSafeNormal());
-	
-	++CurrentProjectileIndex;
-	if (CurrentProjectileIndex == ProjectilePool.Num())
+	AGCProjectile* Projectile = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>()->AcquireProjectile(ProjectileClass, LaunchStart, LaunchDirection.ToOrientationRotator(), GetOwnerPawn());
+	if (!IsValid(Projectile))
 	{
-		CurrentProjectileIndex = 0;
+		return;
 	}
 
+	Projectile->OnProjectileHit.AddDynamic(this, &UWeaponBarellComponent::ProcessProjectileHit);
+	Projectile->LaunchProjectile(LaunchDirection.GetSafeNormal());
+
 }
 
-void UWeaponBarellComponent::ShotInternal(const TArray<FShotInfo>& ShotsInfo)
-{	
-	if(GetOwner()->HasAuthority())
-	{
-		LastShotsInfo = ShotsInfo;	
-	}
+void UWeaponBarellComponent::LaunchSimulatedBullet(const FVector& LaunchStart, const FVector& LaunchDirection)
+{
+	// Every machine simulates bullets of replicated shots, only the server applies damage of their hits.
+	const float GravityZ = GetWorld()->GetGravityZ() * BulletGravityScale;
+	GetWorld()->GetSubsystem<UBulletSimulationSubsystem>()->SpawnBullet(this, LaunchStart, LaunchDirection.GetSafeNormal() * BulletSpeed, GravityZ, BulletLifeTime);
 
-	MuzzleLocation = GetComponentLocation();
-	UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), MuzzleFlashFX, MuzzleLocation, GetComponentRotation());
+}
 
-	for (const FShotInfo& ShotInfo : ShotsInfo)
-	{
-		FVector ShotStart = ShotInfo.GetLocation();
-		FVector ShotDirection = ShotInfo.GetDirection();
-		FVector ShotEnd = ShotStart + FiringRange * ShotDirection;
+void UWeaponBarellComponent::ProcessSimulatedBulletHit(const FHitResult& HitResult, const FVector& Direction, const FVector& SpawnLocation)
+{
+	// Muzzle has moved since the bullet was launched, so the falloff distance is measured from the bullet spawn location.
+	const float Damage = GetDamageAtDistance(FVector::Distance(SpawnLocation, HitResult.ImpactPoint));
+	ApplyDamage(HitResult.GetActor(), Damage, HitResult, Direction);
+	SpawnImpactDecal(HitResult);
+}
+
+void UWeaponBarellComponent::ShotInternal(const TArray<FShotInfo>& ShotsInfo, bool bAllowAsyncHitScan)
+{	
+	const FVector MuzzleLocation = GetComponentLocation();
+	GetWorld()->GetSubsystem<UImpactEffectsSubsystem>()->SpawnEffect(MuzzleFlashFX, MuzzleLocation, GetComponentRotation());
 
 #if ENABLE_DRAW_DEBUG
-		UDebugSubsystem* DebugSubSystem = UGameplayStatics::GetGameInstance(GetWorld())->GetSubsystem<UDebugSubsystem>();
-		bool bIsDebugEnabled = DebugSubSystem->IsCategoryEnabled(DebugCategoryRangeWeapon);
+	UDebugSubsystem* DebugSubSystem = UGameplayStatics::GetGameInstance(GetWorld())->GetSubsystem<UDebugSubsystem>();
+	bool bIsDebugEnabled = DebugSubSystem->IsCategoryEnabled(DebugCategoryRangeWeapon);
 #else
-		bool bIsDebugEnabled = false;
+	bool bIsDebugEnabled = false;
 #endif
-		switch (HitRegistration)
+
+	TArray<FVector> ShotEnds;
+	ShotEnds.Reserve(ShotsInfo.Num());
+	for (const FShotInfo& ShotInfo : ShotsInfo)
+	{
+		ShotEnds.Add(ShotInfo.GetLocation() + FiringRange * ShotInfo.GetDirection());
+	}
+
+	TBitArray<> HasHits(false, ShotsInfo.Num());
+
+	switch (HitRegistration)
+	{
+		case EHitRegistrationType::HitScan:
 		{
-			case EHitRegistrationType::HitScan:
+			if (bUseAsyncHitScan && bAllowAsyncHitScan)
 			{
-				bool bHasHit = HitScan(ShotStart, ShotEnd, ShotDirection);
-
-				if (bIsDebugEnabled && bHasHit)
-				{
-					DrawDebugSphere(GetWorld(), ShotEnd, 10.0f, 24, FColor::Red, false, 5.0f);
-				}
+				// Hits, trace FX and debug are processed when traces are completed.
+				AsyncHitScan(ShotsInfo, ShotEnds, bIsDebugEnabled, MuzzleLocation);
+				return;
+			}
 
+			if (ShotsInfo.Num() > 1)
+			{
+				BatchedHitScan(ShotsInfo, ShotEnds, HasHits, MuzzleLocation);
 				break;
 			}
 
-			case EHitRegistrationType::Projectile:
+			for (int32 i = 0; i < ShotsInfo.Num(); ++i)
 			{
-				LaunchProjectile(ShotStart, ShotDirection);
+				HasHits[i] = HitScan(ShotsInfo[i].GetLocation(), ShotEnds[i], ShotsInfo[i].GetDirection(), MuzzleLocation);
+			}
 
-				break;
+			break;
+		}
+
+		case EHitRegistrationType::Projectile:
+		{
+			for (const FShotInfo& ShotInfo : ShotsInfo)
+			{
+				LaunchProjectile(ShotInfo.GetLocation(), ShotInfo.GetDirection());
 			}
 
-			default:
-				break;
+			break;
+		}
+
+		case EHitRegistrationType::SimulatedBullet:
+		{
+			for (const FShotInfo& ShotInfo : ShotsInfo)
+			{
+				LaunchSimulatedBullet(ShotInfo.GetLocation(), ShotInfo.GetDirection());
+			}
+
+			break;
 		}
 
+		default:
+			break;
+	}
 
+	SpawnTraceFX(ShotEnds, MuzzleLocation, GetComponentRotation());
+	DrawShotsDebug(ShotEnds, HasHits, MuzzleLocation, bIsDebugEnabled);
+}
+
+void UWeaponBarellComponent::DrawShotsDebug(const TArray<FVector>& ShotEnds, const TBitArray<>& HasHits, const FVector& MuzzleLocation, bool bIsDebugEnabled) const
+{
+#if ENABLE_DRAW_DEBUG
+	if (!bIsDebugEnabled)
+	{
+		return;
+	}
 
-		UNiagaraComponent* TraceFXComponent = UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), TraceFX, MuzzleLocation, GetComponentRotation());
-		if (IsValid(TraceFXComponent))
+	for (int32 i = 0; i < ShotEnds.Num(); ++i)
+	{
+		if (HasHits[i])
 		{
-			TraceFXComponent->SetVectorParameter(FXParamTraceEnd, ShotEnd);
+			DrawDebugSphere(GetWorld(), ShotEnds[i], 10.0f, 24, FColor::Red, false, 5.0f);
 		}
 
-		if (bIsDebugEnabled)
+		DrawDebugLine(GetWorld(), MuzzleLocation, ShotEnds[i], FColor::Red, false, 1.0f, 0, 5.0f);
+	}
+#endif
+}
+
+void UWeaponBarellComponent::ProcessShotRequests(const TArray<FShotRequest>& ShotRequests)
+{
+	if (GetOwner()->HasAuthority())
+	{
+		// Shots of one frame are replicated together.
+		if (LastShotRequestsFrame != GFrameCounter)
 		{
-			DrawDebugLine(GetWorld(), MuzzleLocation, ShotEnd, FColor::Red, false, 1.0f, 0, 5.0f);
+			LastShotRequests.Reset();
+			LastShotRequestsFrame = GFrameCounter;
+		}
+
+		LastShotRequests.Append(ShotRequests);
+	}
 
+	// Hitscan of a remote shooter is checked against characters rewound to the time the shooter saw.
+	APawn* OwnerPawn = GetOwnerPawn();
+	ULagCompensationSubsystem* LagCompensationSubsystem = nullptr;
+	if (GetOwner()->HasAuthority() && HitRegistration == EHitRegistrationType::HitScan && IsValid(OwnerPawn) && !OwnerPawn->IsLocallyControlled())
+	{
+		LagCompensationSubsystem = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+	}
+
+	TArray<FShotInfo> ShotsInfo;
+	for (const FShotRequest& ShotRequest : ShotRequests)
+	{
+		GetShotsInfo(ShotRequest, ShotsInfo);
+
+		if (IsValid(LagCompensationSubsystem))
+		{
+			// Rewound collision is restored in this frame, so traces can't be async.
+			LagCompensationSubsystem->RewindCharacters(ShotRequest.ClientTime, OwnerPawn);
+			ShotInternal(ShotsInfo, false);
+			LagCompensationSubsystem->RestoreCharacters();
+		}
+		else
+		{
+			ShotInternal(ShotsInfo);
 		}
 	}
 }
 
-void UWeaponBarellComponent::Server_Shot_Implementation(const TArray<FShotInfo>& ShotsInfo)
+void UWeaponBarellComponent::GetShotsInfo(const FShotRequest& ShotRequest, TArray<FShotInfo>& OutShotsInfo) const
+{
+	OutShotsInfo.Reset(BulletPerShot);
+
+	FRandomStream RandomStream(HashCombine(GetTypeHash(ShotRequest.Seed), GetTypeHash(ShotRequest.ShotCounter)));
+
+	const FVector ShotStart = ShotRequest.GetLocation();
+	FVector ShotDirection = ShotRequest.GetDirection();
+	for (int i = 0; i < BulletPerShot; i++)
+	{
+		ShotDirection += GetBulletSpreadOffset(RandomStream, RandomStream.FRandRange(0.0f, ShotRequest.SpreadAngle), ShotDirection.ToOrientationRotator());
+		ShotDirection = ShotDirection.GetSafeNormal();
+
+		OutShotsInfo.Emplace(ShotStart, ShotDirection);
+
+	}
+}
+
+void UWeaponBarellComponent::SendPendingShotRequests()
+{
+	if (PendingShotRequests.Num() == 0)
+	{
+		return;
+	}
+
+	Server_Shot(PendingShotRequests);
+	PendingShotRequests.Reset();
+}
+
+void UWeaponBarellComponent::Server_Shot_Implementation(const TArray<FShotRequest>& ShotRequests)
 {
-	ShotInternal(ShotsInfo);
+	ProcessShotRequests(ShotRequests);
 
 }
 
-void UWeaponBarellComponent::OnRep_LastShotsInfo()
+void UWeaponBarellComponent::OnRep_LastShotRequests()
 {
-	ShotInternal(LastShotsInfo);
+	ProcessShotRequests(LastShotRequests);
 }
 
 APawn* UWeaponBarellComponent::GetOwnerPawn() const
@@ -263,10 +556,10 @@ AController* UWeaponBarellComponent::GetController() const
 	return IsValid(PawnOwner) ? PawnOwner->GetController() : nullptr;
 }
 
-FVector UWeaponBarellComponent::GetBulletSpreadOffset(float Angle, FRotator ShotRotation) const
+FVector UWeaponBarellComponent::GetBulletSpreadOffset(FRandomStream& RandomStream, float Angle, FRotator ShotRotation) const
 {
 	float SpreadSize = FMath::Tan(Angle);
-	float RotationAngle = FMath::RandRange(0.0f, 2 * PI);
+	float RotationAngle = RandomStream.FRandRange(0.0f, 2 * PI);
 
 	float SpreadY = FMath::Cos(RotationAngle);
 	float SpreadZ = FMath::Sin(RotationAngle);
@@ -4,13 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
+#include "WorldCollision.h"
 #include "WeaponBarellComponent.generated.h"
 
 UENUM(BlueprintType)
 enum class EHitRegistrationType : uint8
 {
 	HitScan,
-	Projectile
+	Projectile,
+	/** Bullet is simulated by the bullet simulation subsystem without an actor */
+	SimulatedBullet
 };
 
 USTRUCT(BlueprintType)
@@ -53,9 +56,62 @@ struct  FShotInfo
 
 };
 
+/** Everything needed to generate bullets of a shot. Bullet directions are generated from the seed on every machine. */
+USTRUCT(BlueprintType)
+struct FShotRequest
+{
+	GENERATED_BODY()
+
+	FShotRequest() : Location_Mul_10(FVector::ZeroVector), Direction(FVector::ZeroVector) {};
+
+	FShotRequest(FVector Location, FVector Direction, float SpreadAngle, uint16 ShotCounter, int32 Seed, float ClientTime)
+		: Location_Mul_10(Location * 10), Direction(Direction), SpreadAngle(SpreadAngle), ShotCounter(ShotCounter), Seed(Seed), ClientTime(ClientTime) {};
+
+	UPROPERTY()
+	FVector_NetQuantize100 Location_Mul_10;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction;
+
+	UPROPERTY()
+	float SpreadAngle = 0.0f;
+
+	UPROPERTY()
+	uint16 ShotCounter = 0;
+
+	UPROPERTY()
+	int32 Seed = 0;
+
+	/** Server world time the shooter saw when the shot was made, used to rewind hit characters */
+	UPROPERTY()
+	float ClientTime = 0.0f;
+
+	FVector GetLocation() const { return Location_Mul_10 * 0.1f; }
+	FVector GetDirection() const { return Direction; }
+
+	/** Rounds location and direction the way replication does, so the shooter generates the same pellets from the seed as other machines */
+	void Quantize();
+
+};
+
+/** Hitscan shot which traces are run asynchronously */
+struct FAsyncHitScanShot
+{
+	TArray<FShotInfo> ShotsInfo;
+	TArray<FTraceHandle> TraceHandles;
+	TArray<FVector> ShotEnds;
+	TArray<FHitResult> HitResults;
+	TBitArray<> HasHits;
+	FVector MuzzleLocation = FVector::ZeroVector;
+	FRotator MuzzleRotation = FRotator::ZeroRotator;
+	int32 CompletedTraces = 0;
+	bool bIsDebugEnabled = false;
+};
+
 class AGCProjectile;
 class UNiagaraSystem;
 class UCurveFloat;
+struct FDamageFalloffTable;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class GAMECODE_API UWeaponBarellComponent : public USceneComponent
@@ -67,10 +123,14 @@ public:
 
 	virtual void BeginPlay() override;
 
-	void Shot(FVector ShotStart, FVector ShotDirection, float SpreadAngle);
+	/** @ShotTimeOffset is how long ago in this frame the shot was due */
+	void Shot(FVector ShotStart, FVector ShotDirection, float SpreadAngle, float ShotTimeOffset = 0.0f);
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	/** Called by the bullet simulation subsystem. Damage is applied on the server only, clients spawn impact cosmetics. */
+	void ProcessSimulatedBulletHit(const FHitResult& HitResult, const FVector& Direction, const FVector& SpawnLocation);
+
 protected:
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes")
@@ -85,9 +145,28 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Hit registration", meta = (EditCondition = "HitRegistration == EHitRegistrationType::Projectile"))
 	TSubclassOf<AGCProjectile> ProjectileClass;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Hit registration", meta = (UIMin = 1.0f, ClampMax = 1.0f, EditCondition = "HitRegistration == EHitRegistrationType::Projectile"))
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Hit registration", meta = (ClampMin = 1.0f, UIMin = 1.0f, EditCondition = "HitRegistration == EHitRegistrationType::SimulatedBullet"))
+	float BulletSpeed = 30000.0f;
+
+	/** Scale of the world gravity applied to simulated bullets */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Hit registration", meta = (EditCondition = "HitRegistration == EHitRegistrationType::SimulatedBullet"))
+	float BulletGravityScale = 1.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Hit registration", meta = (ClampMin = 0.0f, UIMin = 0.0f, EditCondition = "HitRegistration == EHitRegistrationType::SimulatedBullet"))
+	float BulletLifeTime = 2.0f;
+
+	/** Projectiles spawned in the shared projectile pool in advance, pool grows when they are not enough */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Hit registration", meta = (UIMin = 0, ClampMin = 0, EditCondition = "HitRegistration == EHitRegistrationType::Projectile"))
 	int32 ProjectilePoolSize = 10;
 
+	/** Traces run on worker threads and hits are processed next frame. Cheaper for AI, player weapons should stay synchronous. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Hit registration", meta = (EditCondition = "HitRegistration == EHitRegistrationType::HitScan"))
+	bool bUseAsyncHitScan = false;
+
+	/** Bullets of a shot are traced against the world if its cone contains more blocking components than this */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Hit registration", meta = (ClampMin = 1, UIMin = 1, EditCondition = "HitRegistration == EHitRegistrationType::HitScan"))
+	int32 MaxBatchedHitScanCandidates = 32;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Damage")
 	float DamageAmount = 20.0f;
 
@@ -100,6 +179,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | VFX")
 	UNiagaraSystem* TraceFX;
 
+	/** Spawned once for a shot with several bullets, gets all trace ends in TraceEnds vector array. TraceFX is spawned per bullet if it isn't set. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | VFX")
+	UNiagaraSystem* MultiTraceFX;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Barell attributes | Decals")
 	FDecalInfo DefaultDecalInfo;
 
@@ -108,26 +191,29 @@ protected:
 
 
 private:
-	void ShotInternal(const TArray<FShotInfo>& ShotsInfo);
+	void ShotInternal(const TArray<FShotInfo>& ShotsInfo, bool bAllowAsyncHitScan = true);
+	void ProcessShotRequests(const TArray<FShotRequest>& ShotRequests);
+	void GetShotsInfo(const FShotRequest& ShotRequest, TArray<FShotInfo>& OutShotsInfo) const;
+	void SendPendingShotRequests();
 
+	/** All shots of a client frame are sent in one call */
 	UFUNCTION(Server, Reliable)
-	void Server_Shot( const TArray<FShotInfo>& ShotsInfo);
+	void Server_Shot(const TArray<FShotRequest>& ShotRequests);
 
-	UPROPERTY(ReplicatedUsing = OnRep_LastShotsInfo)
-	TArray<FShotInfo> LastShotsInfo;
+	/** Shots made by the server in the last frame it made shots */
+	UPROPERTY(ReplicatedUsing = OnRep_LastShotRequests)
+	TArray<FShotRequest> LastShotRequests;
 
-	UPROPERTY(Replicated)
-	TArray<AGCProjectile*> ProjectilePool;
+	uint64 LastShotRequestsFrame = 0;
 
-	UPROPERTY(Replicated)
-	int32 CurrentProjectileIndex;
+	TArray<FShotRequest> PendingShotRequests;
+	uint16 ShotCounter = 0;
 
 	UFUNCTION()
-	void OnRep_LastShotsInfo();
+	void OnRep_LastShotRequests();
 
 	APawn* GetOwnerPawn() const;
 	AController* GetController() const; 
-	FVector MuzzleLocation = FVector::ZeroVector;
 
 	UFUNCTION()
 	void ProcessProjectileHit(AGCProjectile* Projectile, const FHitResult& HitResult, const FVector& Direction);
@@ -135,14 +221,32 @@ private:
 	UFUNCTION()
 	void ProcessHit(const FHitResult& HitResult, const FVector& Direction);
 
-	bool HitScan(FVector ShotStart, OUT FVector& ShotEnd, FVector ShotDirection);
+	bool HitScan(FVector ShotStart, OUT FVector& ShotEnd, FVector ShotDirection, const FVector& MuzzleLocation);
+	/** Finds blocking components in the cone of all bullets with one overlap, then traces every bullet against them only */
+	void BatchedHitScan(const TArray<FShotInfo>& ShotsInfo, TArray<FVector>& InOutShotEnds, TBitArray<>& OutHasHits, const FVector& MuzzleLocation);
+	void ProcessHitScanResults(const TArray<FShotInfo>& ShotsInfo, const TArray<FHitResult>& HitResults, const TBitArray<>& HasHits, const FVector& MuzzleLocation);
+	void AsyncHitScan(const TArray<FShotInfo>& ShotsInfo, const TArray<FVector>& ShotEnds, bool bIsDebugEnabled, const FVector& MuzzleLocation);
+	void OnAsyncHitScanCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	bool HitScanComponents(const TArray<UPrimitiveComponent*>& Components, const FVector& ShotStart, const FVector& ShotEnd, FHitResult& OutHitResult) const;
+	/** @MuzzleLocation is where the muzzle was when the shot was made */
+	float GetHitScanDamage(const FVector& ImpactPoint, const FVector& MuzzleLocation) const;
+	/** Damage of a hit at @Distance from the muzzle. Doesn't depend on previous hits. */
+	float GetDamageAtDistance(float Distance) const;
+	void ApplyDamage(AActor* HitActor, float Damage, const FHitResult& HitResult, const FVector& Direction);
+	void SpawnImpactDecal(const FHitResult& HitResult);
+	void SpawnTraceFX(const TArray<FVector>& ShotEnds, const FVector& MuzzleLocation, const FRotator& MuzzleRotation);
+	void DrawShotsDebug(const TArray<FVector>& ShotEnds, const TBitArray<>& HasHits, const FVector& MuzzleLocation, bool bIsDebugEnabled) const;
+
+	FTraceDelegate AsyncHitScanDelegate;
+	/** Shots waiting for async traces, by shot id passed as trace user data */
+	TMap<uint32, FAsyncHitScanShot> AsyncHitScanShots;
+	uint32 NextAsyncHitScanShotId = 0;
 	void LaunchProjectile(const FVector& LaunchStart, const FVector& LaunchDirection);
+	void LaunchSimulatedBullet(const FVector& LaunchStart, const FVector& LaunchDirection);
 
-	UPROPERTY(Replicated)
-	float SaveCurveDamage = 0.0f;
-
-	FVector GetBulletSpreadOffset(float Angle, FRotator ShotRotation) const;
+	/** @FalloffDiagrama baked into a table shared by all weapons with this curve */
+	TSharedPtr<const FDamageFalloffTable> FalloffTable;
 
-	const FVector ProjectilePoolLocation = FVector(0.0f, 0.0f, -100.0f);
+	FVector GetBulletSpreadOffset(FRandomStream& RandomStream, float Angle, FRotator ShotRotation) const;
 
 };
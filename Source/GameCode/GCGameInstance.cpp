@@ -7,6 +7,7 @@
 #include "OnlineSubsystemUtils.h"
 #include "OnlineSubsystemTypes.h"
 #include "Kismet/GameplayStatics.h"
+#include "Subsystems/WorldSubsystem.h"
 
 
 UGCGameInstance::UGCGameInstance()
@@ -41,6 +42,16 @@ bool UGCGameInstance::ProcessConsoleExec(const TCHAR* Cmd, FOutputDevice& Ar, UO
 			bResult |= Subsystem->ProcessConsoleExec(Cmd, Ar, Executor);
 						
 		}
+
+		// World subsystems of the current world, e.g. projectile pools.
+		UWorld* World = GetWorld();
+		if (!bResult && IsValid(World))
+		{
+			for (UWorldSubsystem* Subsystem : World->GetSubsystemArray<UWorldSubsystem>())
+			{
+				bResult |= Subsystem->ProcessConsoleExec(Cmd, Ar, Executor);
+			}
+		}
 	}
 
 	return bResult;
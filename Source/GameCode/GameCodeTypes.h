@@ -20,8 +20,10 @@ const FName DebugCategoryLedgeDetection = FName("LedgeDetection");
 const FName DebugCategoryCharacterAttributes = FName("CharacterAttributes");
 const FName DebugCategoryRangeWeapon = FName("RangeWeapon");
 const FName DebugCategoryMeleeWeapon = FName("MeleeWeapon");
+const FName DebugCategoryFootIK = FName("FootIK");
 
 const FName FXParamTraceEnd = FName("TraceEnd");
+const FName FXParamTraceEnds = FName("TraceEnds");
 const FName SectionMontageReloadEnd = FName("ReloadEnd");
 
 const FName BB_CurrentTarget = FName("CurrentTarget");
@@ -14,7 +14,6 @@
 #include "GameFramework/PlayerInput.h"
 #include "Subsystems/SaveSubsystem/SaveSubsystem.h"
 #include "Kismet/GameplayStatics.h"
-#include "SignificanceManager.h"
 #include "Subsystems/DebugSubsystem.h"
 
 void AGCPlayerController::SetPawn(APawn* InPawn)
@@ -30,23 +29,6 @@ void AGCPlayerController::SetPawn(APawn* InPawn)
 	}
 }
 
-void AGCPlayerController::Tick(float DeltaSeconds)
-{
-	Super::Tick(DeltaSeconds);
-
-	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
-	if (IsValid(SignificanceManager))
-	{
-		FVector ViewLocation;
-		FRotator ViewRotation;
-		GetPlayerViewPoint(ViewLocation, ViewRotation);
-		FTransform ViewTransform(ViewRotation, ViewLocation);
-		TArray<FTransform> Viewpoints = { ViewTransform };
-		SignificanceManager->Update(Viewpoints);
-		 
-	}
-}
-
 bool AGCPlayerController::GetIgnoreCameraPitch() const
 {
 	return bIgnoreCameraPitch;
@@ -17,8 +17,6 @@ public:
 	
 	virtual void SetPawn(APawn* InPawn) override;
 
-	virtual void Tick(float DeltaSeconds) override;
-
 	bool GetIgnoreCameraPitch() const;
 
 	void SetIgnoreCameraPitch(bool bIgnoreCameraPitch_In);
@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Pawns/Character/CharacterSignificancePolicy.h"
+#include "GameCodeTypes.h"
+
+UCharacterSignificancePolicy::UCharacterSignificancePolicy()
+{
+	VeryHigh.Movement = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	VeryHigh.Mesh = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	VeryHigh.AIController = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	VeryHigh.FootIK = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	VeryHigh.LineOfSight = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	VeryHigh.Attributes = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	VeryHigh.SprintState = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	VeryHigh.bIsHealthBarVisible = true;
+
+	High.Movement = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	High.Mesh = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.05f);
+	High.AIController = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	High.FootIK = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.05f);
+	High.LineOfSight = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	High.Attributes = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	High.SprintState = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Full);
+	High.bIsHealthBarVisible = true;
+
+	Medium.Movement = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.1f);
+	Medium.Mesh = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.1f);
+	Medium.AIController = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.1f);
+	Medium.FootIK = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.1f);
+	Medium.LineOfSight = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.1f);
+	Medium.Attributes = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.1f);
+	Medium.SprintState = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.1f);
+	Medium.bIsHealthBarVisible = false;
+
+	Low.Movement = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 1.0f);
+	Low.Mesh = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 1.0f);
+	Low.AIController = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 1.0f);
+	Low.FootIK = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Disabled);
+	Low.LineOfSight = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Disabled);
+	Low.Attributes = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.5f);
+	Low.SprintState = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 0.5f);
+	Low.bIsHealthBarVisible = false;
+
+	VeryLow.Movement = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 5.0f);
+	VeryLow.Mesh = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Disabled);
+	VeryLow.AIController = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 10.0f);
+	VeryLow.FootIK = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Disabled);
+	VeryLow.LineOfSight = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Disabled);
+	VeryLow.Attributes = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 1.0f);
+	VeryLow.SprintState = FSignificanceFeaturePolicy(ESignificanceFeatureRate::Reduced, 1.0f);
+	VeryLow.bIsHealthBarVisible = false;
+}
+
+const FCharacterSignificanceBandPolicy& UCharacterSignificancePolicy::GetBandPolicy(ECharacterSignificanceBand Band) const
+{
+	switch (Band)
+	{
+		case ECharacterSignificanceBand::High:
+			return High;
+		case ECharacterSignificanceBand::Medium:
+			return Medium;
+		case ECharacterSignificanceBand::Low:
+			return Low;
+		case ECharacterSignificanceBand::VeryLow:
+			return VeryLow;
+		default:
+			return VeryHigh;
+	}
+}
+
+ECharacterSignificanceBand UCharacterSignificancePolicy::GetSignificanceBand(float Significance)
+{
+	if (Significance >= SignificanceValueVeryLow)
+	{
+		return ECharacterSignificanceBand::VeryLow;
+	}
+	else if (Significance >= SignificanceValueLow)
+	{
+		return ECharacterSignificanceBand::Low;
+	}
+	else if (Significance >= SignificanceValueMedium)
+	{
+		return ECharacterSignificanceBand::Medium;
+	}
+	else if (Significance >= SignificanceValueHith)
+	{
+		return ECharacterSignificanceBand::High;
+	}
+
+	return ECharacterSignificanceBand::VeryHigh;
+}
+
+void FSignificanceFeatureTimer::SetPolicy(const FSignificanceFeaturePolicy& Policy)
+{
+	bIsEnabled = Policy.IsEnabled();
+	Interval = Policy.GetInterval();
+	TimeToUpdate = FMath::Min(TimeToUpdate, Interval);
+}
+
+bool FSignificanceFeatureTimer::Update(float DeltaTime)
+{
+	if (!bIsEnabled)
+	{
+		return false;
+	}
+
+	TimeToUpdate -= DeltaTime;
+	if (TimeToUpdate > 0.0f)
+	{
+		return false;
+	}
+
+	TimeToUpdate = Interval;
+	return true;
+}
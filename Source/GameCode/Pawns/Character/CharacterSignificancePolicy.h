@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CharacterSignificancePolicy.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("CharacterSignificance"), STATGROUP_CharacterSignificance, STATCAT_Advanced);
+
+UENUM(BlueprintType)
+enum class ECharacterSignificanceBand : uint8
+{
+	VeryHigh,
+	High,
+	Medium,
+	Low,
+	VeryLow,
+	Max UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class ESignificanceFeatureRate : uint8
+{
+	Full,
+	Reduced,
+	Disabled
+};
+
+USTRUCT(BlueprintType)
+struct FSignificanceFeaturePolicy
+{
+	GENERATED_BODY()
+
+	FSignificanceFeaturePolicy() {};
+
+	FSignificanceFeaturePolicy(ESignificanceFeatureRate Rate, float ReducedInterval = 0.0f) : Rate(Rate), ReducedInterval(ReducedInterval) {};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	ESignificanceFeatureRate Rate = ESignificanceFeatureRate::Full;
+
+	/** Seconds between updates of the reduced rate */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance", meta = (ClampMin = 0.0f, UIMin = 0.0f, EditCondition = "Rate == ESignificanceFeatureRate::Reduced"))
+	float ReducedInterval = 0.1f;
+
+	bool IsEnabled() const { return Rate != ESignificanceFeatureRate::Disabled; }
+	float GetInterval() const { return Rate == ESignificanceFeatureRate::Reduced ? ReducedInterval : 0.0f; }
+};
+
+/** What a character updates and how often inside one significance band */
+USTRUCT(BlueprintType)
+struct FCharacterSignificanceBandPolicy
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FSignificanceFeaturePolicy Movement;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FSignificanceFeaturePolicy Mesh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FSignificanceFeaturePolicy AIController;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FSignificanceFeaturePolicy FootIK;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FSignificanceFeaturePolicy LineOfSight;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FSignificanceFeaturePolicy Attributes;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FSignificanceFeaturePolicy SprintState;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	bool bIsHealthBarVisible = true;
+};
+
+/**
+ * Per feature update rates of characters in every significance band. Characters without a policy use the default one.
+ */
+UCLASS(BlueprintType)
+class GAMECODE_API UCharacterSignificancePolicy : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UCharacterSignificancePolicy();
+
+	const FCharacterSignificanceBandPolicy& GetBandPolicy(ECharacterSignificanceBand Band) const;
+
+	static ECharacterSignificanceBand GetSignificanceBand(float Significance);
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FCharacterSignificanceBandPolicy VeryHigh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FCharacterSignificanceBandPolicy High;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FCharacterSignificanceBandPolicy Medium;
+
+	/** AI characters in this band and below should do no per-frame traces */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FCharacterSignificanceBandPolicy Low;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Significance")
+	FCharacterSignificanceBandPolicy VeryLow;
+};
+
+/** Tells when a feature updated with a significance policy is due */
+struct FSignificanceFeatureTimer
+{
+public:
+	void SetPolicy(const FSignificanceFeaturePolicy& Policy);
+	bool IsEnabled() const { return bIsEnabled; }
+
+	/** Returns true if the feature should be updated this frame */
+	bool Update(float DeltaTime);
+
+private:
+	float Interval = 0.0f;
+	float TimeToUpdate = 0.0f;
+	bool bIsEnabled = true;
+};
@@ -5,7 +5,6 @@
 #include "AIController.h"
 #include "Net/UnrealNetwork.h"
 #include "Curves/CurveVector.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "GameFramework/PhysicsVolume.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "CharacterMovementComponent/GCBaseCharacterMovementComponent.h"
@@ -25,6 +24,14 @@
 #include "Inventory/Items/InventoryItem.h"
 #include "GameCodeTypes.h"
 #include "SignificanceManager.h"
+#include "Subsystems/LagCompensation/LagCompensationSubsystem.h"
+#include "Subsystems/FootIK/FootIKSubsystem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Characters VeryHigh"), STAT_CharactersVeryHighSignificance, STATGROUP_CharacterSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Characters High"), STAT_CharactersHighSignificance, STATGROUP_CharacterSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Characters Medium"), STAT_CharactersMediumSignificance, STATGROUP_CharacterSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Characters Low"), STAT_CharactersLowSignificance, STATGROUP_CharacterSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Characters VeryLow"), STAT_CharactersVeryLowSignificance, STATGROUP_CharacterSignificance);
 
 AGCBaseCharacter::AGCBaseCharacter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UGCBaseCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
@@ -62,6 +69,11 @@ void AGCBaseCharacter::BeginPlay()
 
 	InitializeHealthProgress();
 
+	if (HasAuthority())
+	{
+		GetWorld()->GetSubsystem<ULagCompensationSubsystem>()->RegisterCharacter(this);
+	}
+
 	if (bIsSignificanceEnabled)
 	{
 		USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
@@ -92,6 +104,24 @@ void AGCBaseCharacter::EndPlay(const EEndPlayReason::Type Reason)
 
 	}
 
+	if (HasAuthority())
+	{
+		ULagCompensationSubsystem* LagCompensationSubsystem = GetWorld()->GetSubsystem<ULagCompensationSubsystem>();
+		if (IsValid(LagCompensationSubsystem))
+		{
+			LagCompensationSubsystem->UnregisterCharacter(this);
+		}
+	}
+
+	UFootIKSubsystem* FootIKSubsystem = GetWorld()->GetSubsystem<UFootIKSubsystem>();
+	if (IsValid(FootIKSubsystem))
+	{
+		FootIKSubsystem->UnregisterRequester(this);
+	}
+
+	ChangeSignificanceBandStat(SignificanceBand, -1);
+	SignificanceBand = ECharacterSignificanceBand::Max;
+
 	Super::EndPlay(Reason);
 }
 
@@ -107,6 +137,13 @@ void AGCBaseCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Out
 
 }
 
+void AGCBaseCharacter::PostNetReceiveRole()
+{
+	Super::PostNetReceiveRole();
+
+	LedgeDetertorComponent->UpdateProbeTickEnabled();
+}
+
 void AGCBaseCharacter::PossessedBy(AController* NewController)
 {
 	Super::PossessedBy(NewController);
@@ -124,10 +161,21 @@ void AGCBaseCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	TryChangeSprintState(DeltaTime);
-	UpdateIkSetting(DeltaTime);
+	if (SprintStateTimer.Update(DeltaTime))
+	{
+		TryChangeSprintState(DeltaTime);
+	}
 
-	TraceLineOfSight();
+	// Trace rate of foot IK is reduced by the foot IK subsystem, offsets are still interpolated every frame.
+	if (FootIKTimer.IsEnabled())
+	{
+		UpdateIkSetting(DeltaTime);
+	}
+
+	if (LineOfSightTimer.Update(DeltaTime))
+	{
+		TraceLineOfSight();
+	}
 }
 
 void AGCBaseCharacter::ChangeCrouchState()
@@ -356,6 +404,16 @@ void AGCBaseCharacter::OnRep_IsMantlong(bool bWasMantling)
 	}
 }
 
+ULedgeDetectorComponent* AGCBaseCharacter::GetLedgeDetectorComponent() const
+{
+	return LedgeDetertorComponent;
+}
+
+float AGCBaseCharacter::GetLowMantleMaxHeight() const
+{
+	return LowMantleMaxHeight;
+}
+
 void AGCBaseCharacter::StartFire()
 {	
 	if (CharacterEquipmentComponent->IsSelectingWeapon())
@@ -867,11 +925,6 @@ float AGCBaseCharacter::SingnificanceFunction(USignificanceManager::FManagedObje
 
 void AGCBaseCharacter::PostSignificanceFunction(USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
 {
-	if (OldSignificance == Significance)
-	{
-		return;
-	}
-
 	if (ObjectInfo->GetTag() != SignificanceTagCharacter)
 	{
 		return;
@@ -882,107 +935,126 @@ void AGCBaseCharacter::PostSignificanceFunction(USignificanceManager::FManagedOb
 	{
 		return;
 	}
-	
-	UCharacterMovementComponent* MovementComponent = Character->GetBaseCharacterMovementComponent();
-	AAIController* AIController = Character->GetController<AAIController>();
-	UWidgetComponent* Widget =  Character->HealthBarProgressComponent;
 
-	if (Significance == SignificanceValueVeryHith)
+	// Band is compared instead of significance, so the band a character starts in is applied too.
+	ECharacterSignificanceBand NewSignificanceBand = UCharacterSignificancePolicy::GetSignificanceBand(Significance);
+	if (NewSignificanceBand != Character->SignificanceBand)
 	{
-		MovementComponent->SetComponentTickInterval(0.0f);
-		Widget->SetVisibility(true);
-		Character->GetMesh()->SetComponentTickEnabled(true);
-		Character->GetMesh()->SetComponentTickInterval(0.0f);
-
-		if (IsValid(AIController))
-		{
-			AIController->SetActorTickInterval(0.0f);
-
-		}
-
+		Character->ApplySignificanceBand(NewSignificanceBand);
 	}
-	else if (Significance == SignificanceValueHith)
-	{
-		MovementComponent->SetComponentTickInterval(0.0f);
-		Widget->SetVisibility(true);
-		Character->GetMesh()->SetComponentTickEnabled(true);
-		Character->GetMesh()->SetComponentTickInterval(0.05f);
 
-		if (IsValid(AIController))
-		{
-			AIController->SetActorTickInterval(0.0f);
+}
 
-		}
+void AGCBaseCharacter::ApplySignificanceBand(ECharacterSignificanceBand NewSignificanceBand)
+{
+	ChangeSignificanceBandStat(SignificanceBand, -1);
+	ChangeSignificanceBandStat(NewSignificanceBand, 1);
+	SignificanceBand = NewSignificanceBand;
 
-	}
-	else if (Significance == SignificanceValueMedium)
-	{
-		MovementComponent->SetComponentTickInterval(0.1f);
-		Widget->SetVisibility(false);
-		Character->GetMesh()->SetComponentTickEnabled(true);
-		Character->GetMesh()->SetComponentTickInterval(0.1f);
+	const UCharacterSignificancePolicy* Policy = IsValid(SignificancePolicy) ? SignificancePolicy : GetDefault<UCharacterSignificancePolicy>();
+	const FCharacterSignificanceBandPolicy& BandPolicy = Policy->GetBandPolicy(SignificanceBand);
 
-		if (IsValid(AIController))
-		{
-			AIController->SetActorTickInterval(0.1f);
+	ApplyComponentSignificancePolicy(GetBaseCharacterMovementComponent(), BandPolicy.Movement);
+	ApplyComponentSignificancePolicy(GetMesh(), BandPolicy.Mesh);
+	ApplyComponentSignificancePolicy(CharacterAttributeComponent, BandPolicy.Attributes);
+	HealthBarProgressComponent->SetVisibility(BandPolicy.bIsHealthBarVisible);
 
-		}
-	}
-	else if (Significance == SignificanceValueLow)
+	AAIController* AIController = GetController<AAIController>();
+	if (IsValid(AIController))
 	{
-		MovementComponent->SetComponentTickInterval(1.0f);
-		Widget->SetVisibility(false);
-		Character->GetMesh()->SetComponentTickEnabled(true);
-		Character->GetMesh()->SetComponentTickInterval(1.0f);
-
-		if (IsValid(AIController))
-		{
-			AIController->SetActorTickInterval(1.0f);
+		AIController->SetActorTickEnabled(BandPolicy.AIController.IsEnabled());
+		AIController->SetActorTickInterval(BandPolicy.AIController.GetInterval());
+	}
 
-		}
+	UFootIKSubsystem* FootIKSubsystem = GetWorld()->GetSubsystem<UFootIKSubsystem>();
+	if (BandPolicy.FootIK.IsEnabled())
+	{
+		FootIKSubsystem->SetTraceInterval(this, BandPolicy.FootIK.GetInterval());
 	}
-	else if (Significance == SignificanceValueVeryLow)
+	else
 	{
-		MovementComponent->SetComponentTickInterval(5.0f);
-		Widget->SetVisibility(false);
-		Character->GetMesh()->SetComponentTickEnabled(false);
+		FootIKSubsystem->UnregisterRequester(this);
+		IKLeftFootSocketOffset = 0.0f;
+		IKRightFootSocketOffset = 0.0f;
+		IKPelvisOffset = 0.0f;
+	}
 
-		if (IsValid(AIController))
-		{
-			AIController->SetActorTickInterval(10.0f);
+	FootIKTimer.SetPolicy(BandPolicy.FootIK);
+	LineOfSightTimer.SetPolicy(BandPolicy.LineOfSight);
+	SprintStateTimer.SetPolicy(BandPolicy.SprintState);
+}
 
-		}
+void AGCBaseCharacter::ApplyComponentSignificancePolicy(UActorComponent* Component, const FSignificanceFeaturePolicy& Policy)
+{
+	if (IsValid(Component))
+	{
+		Component->SetComponentTickEnabled(Policy.IsEnabled());
+		Component->SetComponentTickInterval(Policy.GetInterval());
 	}
+}
 
+void AGCBaseCharacter::ChangeSignificanceBandStat(ECharacterSignificanceBand Band, int32 Delta)
+{
+	switch (Band)
+	{
+		case ECharacterSignificanceBand::VeryHigh:
+			INC_DWORD_STAT_BY(STAT_CharactersVeryHighSignificance, Delta);
+			break;
+		case ECharacterSignificanceBand::High:
+			INC_DWORD_STAT_BY(STAT_CharactersHighSignificance, Delta);
+			break;
+		case ECharacterSignificanceBand::Medium:
+			INC_DWORD_STAT_BY(STAT_CharactersMediumSignificance, Delta);
+			break;
+		case ECharacterSignificanceBand::Low:
+			INC_DWORD_STAT_BY(STAT_CharactersLowSignificance, Delta);
+			break;
+		case ECharacterSignificanceBand::VeryLow:
+			INC_DWORD_STAT_BY(STAT_CharactersVeryLowSignificance, Delta);
+			break;
+		default:
+			break;
+	}
 }
 
 void AGCBaseCharacter::UpdateIkSetting(float DeltaSeconds)
 {
+	// Traces are batched by the foot IK subsystem, offsets use results of the previous batch.
+	UFootIKSubsystem* FootIKSubsystem = GetWorld()->GetSubsystem<UFootIKSubsystem>();
+	if (FootIKSubsystem->IsTraceDue(this))
+	{
+		RequestIKTrace(FootIKSubsystem, 0, LeftFootSocketName);
+		RequestIKTrace(FootIKSubsystem, 1, RightFootSocketName);
+	}
 
-	IKLeftFootSocketOffset = FMath::FInterpTo(IKLeftFootSocketOffset, GetIKOffsetForSocket(LeftFootSocketName), DeltaSeconds, IKInterpSpeed);
-	IKRightFootSocketOffset = FMath::FInterpTo(IKRightFootSocketOffset, GetIKOffsetForSocket(RightFootSocketName), DeltaSeconds, IKInterpSpeed);
+	IKLeftFootSocketOffset = FMath::FInterpTo(IKLeftFootSocketOffset, GetIKOffsetForTrace(FootIKSubsystem, 0), DeltaSeconds, IKInterpSpeed);
+	IKRightFootSocketOffset = FMath::FInterpTo(IKRightFootSocketOffset, GetIKOffsetForTrace(FootIKSubsystem, 1), DeltaSeconds, IKInterpSpeed);
 	IKPelvisOffset = FMath::FInterpTo(IKPelvisOffset, CalculateIKPelvisOffset(), DeltaSeconds, IKInterpSpeed);
 
 }
 
 //
-float AGCBaseCharacter::GetIKOffsetForSocket(const FName& SocketName) const
+void AGCBaseCharacter::RequestIKTrace(UFootIKSubsystem* FootIKSubsystem, int32 TraceIndex, const FName& SocketName) const
 {
-	float Result = 0.0f;
-
 	float CapsuleHalfHeight = GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
 
 	FVector SocketLocation = GetMesh()->GetSocketLocation(SocketName);
 	FVector TraceStart(SocketLocation.X, SocketLocation.Y, GetActorLocation().Z);
 	FVector TraceEnd = TraceStart - (CapsuleHalfHeight + IKTraceDistance) * FVector::UpVector;
 
-	FHitResult HitResult;
+	FootIKSubsystem->RequestTrace(this, TraceIndex, TraceStart, TraceEnd);
+}
+
+float AGCBaseCharacter::GetIKOffsetForTrace(UFootIKSubsystem* FootIKSubsystem, int32 TraceIndex) const
+{
+	float Result = 0.0f;
 
-	ETraceTypeQuery TraceType = UEngineTypes::ConvertToTraceType(ECC_Visibility);
-	if (UKismetSystemLibrary::LineTraceSingle(GetWorld(), TraceStart, TraceEnd, TraceType, true, TArray<AActor*>(), EDrawDebugTrace::ForOneFrame, HitResult, true))
+	FVector TraceStart;
+	FVector HitLocation;
+	if (FootIKSubsystem->GetTraceResult(this, TraceIndex, TraceStart, HitLocation))
 	{	
-		float CharacterBottom = TraceStart.Z - CapsuleHalfHeight;
-		Result = CharacterBottom - HitResult.Location.Z;	
+		float CharacterBottom = TraceStart.Z - GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		Result = CharacterBottom - HitLocation.Z;	
 	}
 
 	return Result;
@@ -9,6 +9,7 @@
 #include <UObject/ScriptInterface.h>
 #include <Subsystems/SaveSubsystem/SaveSubsystemInterface.h>
 #include "SignificanceManager.h"
+#include "CharacterSignificancePolicy.h"
 #include "GCBaseCharacter.generated.h"
 
 class IInteractable;
@@ -58,6 +59,7 @@ class UCharacterEquipmentComponent;
 class UCharacterAttributeComponent;
 class UCharacterInventoryComponent;
 class UWidgetComponent;
+class UFootIKSubsystem;
 
 UCLASS(Abstract,NotBlueprintable)
 class GAMECODE_API AGCBaseCharacter : public ACharacter, public IGenericTeamAgentInterface, public ISaveSubsystemInterface
@@ -78,6 +80,7 @@ public:
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void PossessedBy(AController* NewController) override;
+	virtual void PostNetReceiveRole() override;
 
 	virtual void Tick(float DeltaTime) override;
 
@@ -142,6 +145,11 @@ public:
 	UFUNCTION()
 	void OnRep_IsMantlong(bool bWasMantling);
 
+	class ULedgeDetectorComponent* GetLedgeDetectorComponent() const;
+
+	/** Ledges higher than this use high mantle settings */
+	float GetLowMantleMaxHeight() const;
+
 	//Fire
 	void StartFire();
 	void StopFire();
@@ -327,10 +335,23 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character | Significance")
 	float LowSignificanceDistance = 6000.0f;
 
+	/** Update rates of character features in every significance band. Default policy is used if it isn't set. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character | Significance")
+	UCharacterSignificancePolicy* SignificancePolicy;
+
 private:
 
+	/** Evaluated by the significance manager on worker threads for every viewpoint, must only read character state */
 	float SingnificanceFunction(USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& ViewPoint);
 	void PostSignificanceFunction(USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal);
+	void ApplySignificanceBand(ECharacterSignificanceBand NewSignificanceBand);
+	static void ApplyComponentSignificancePolicy(UActorComponent* Component, const FSignificanceFeaturePolicy& Policy);
+	static void ChangeSignificanceBandStat(ECharacterSignificanceBand Band, int32 Delta);
+
+	ECharacterSignificanceBand SignificanceBand = ECharacterSignificanceBand::Max;
+	FSignificanceFeatureTimer FootIKTimer;
+	FSignificanceFeatureTimer LineOfSightTimer;
+	FSignificanceFeatureTimer SprintStateTimer;
 
 	//Fall
 	FVector CurrentFallApex;
@@ -338,7 +359,8 @@ private:
 
 	//
 	void UpdateIkSetting(float DeltaSeconds);
-	float GetIKOffsetForSocket(const FName& SocketName) const;
+	void RequestIKTrace(UFootIKSubsystem* FootIKSubsystem, int32 TraceIndex, const FName& SocketName) const;
+	float GetIKOffsetForTrace(UFootIKSubsystem* FootIKSubsystem, int32 TraceIndex) const;
 	float CalculateIKPelvisOffset();
 
 	float IKRightFootSocketOffset = 0.0f;
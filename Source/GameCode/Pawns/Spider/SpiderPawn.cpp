@@ -3,7 +3,7 @@
 
 #include "SpiderPawn.h"
 #include "Components/SkeletalMeshComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
+#include "Subsystems/FootIK/FootIKSubsystem.h"
 
 ASpiderPawn::ASpiderPawn()
 {
@@ -18,30 +18,52 @@ void ASpiderPawn::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	IKRightFrontFootOffset = FMath::FInterpTo(IKRightFrontFootOffset, GetIKOffsetForASosket(RightFrontFootSocketName), DeltaSeconds, IKInterpSpeed);
-	IKRightRearFootOffset = FMath::FInterpTo(IKRightRearFootOffset, GetIKOffsetForASosket(RightRearFootSocketName), DeltaSeconds, IKInterpSpeed);
-	IKLeftFrontFootOffset = FMath::FInterpTo(IKLeftFrontFootOffset, GetIKOffsetForASosket(LeftFrontFootSocketName), DeltaSeconds, IKInterpSpeed);
-	IKLeftRearFootOffset = FMath::FInterpTo(IKLeftRearFootOffset, GetIKOffsetForASosket(LeftRearFootSocketName), DeltaSeconds, IKInterpSpeed);
+	UFootIKSubsystem* FootIKSubsystem = GetWorld()->GetSubsystem<UFootIKSubsystem>();
+	if (FootIKSubsystem->IsTraceDue(this))
+	{
+		RequestIKTrace(FootIKSubsystem, 0, RightFrontFootSocketName);
+		RequestIKTrace(FootIKSubsystem, 1, RightRearFootSocketName);
+		RequestIKTrace(FootIKSubsystem, 2, LeftFrontFootSocketName);
+		RequestIKTrace(FootIKSubsystem, 3, LeftRearFootSocketName);
+	}
+
+	IKRightFrontFootOffset = FMath::FInterpTo(IKRightFrontFootOffset, GetIKOffsetForTrace(FootIKSubsystem, 0), DeltaSeconds, IKInterpSpeed);
+	IKRightRearFootOffset = FMath::FInterpTo(IKRightRearFootOffset, GetIKOffsetForTrace(FootIKSubsystem, 1), DeltaSeconds, IKInterpSpeed);
+	IKLeftFrontFootOffset = FMath::FInterpTo(IKLeftFrontFootOffset, GetIKOffsetForTrace(FootIKSubsystem, 2), DeltaSeconds, IKInterpSpeed);
+	IKLeftRearFootOffset = FMath::FInterpTo(IKLeftRearFootOffset, GetIKOffsetForTrace(FootIKSubsystem, 3), DeltaSeconds, IKInterpSpeed);
 }
 
-float ASpiderPawn::GetIKOffsetForASosket(const FName& SocketName)
+void ASpiderPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UFootIKSubsystem* FootIKSubsystem = GetWorld()->GetSubsystem<UFootIKSubsystem>();
+	if (IsValid(FootIKSubsystem))
+	{
+		FootIKSubsystem->UnregisterRequester(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASpiderPawn::RequestIKTrace(UFootIKSubsystem* FootIKSubsystem, int32 TraceIndex, const FName& SocketName) const
 {
-	float Result = 0.0f;
-	
 	FVector SocketLocation = SkeletalMeshComponent->GetSocketLocation(SocketName);
 	FVector TraceStart(SocketLocation.X, SocketLocation.Y, GetActorLocation().Z);
-	FVector TraceEnd = TraceStart - IKTraceDistance * FVector::UpVector;
+	// One trace covers the extended distance the second trace was used for.
+	FVector TraceEnd = TraceStart - (IKTraceDistance + IKTraceExtendDistance) * FVector::UpVector;
 
-	FHitResult HitResult;
-	ETraceTypeQuery TraceType = UEngineTypes::ConvertToTraceType(ECC_Visibility);
-	if (UKismetSystemLibrary::LineTraceSingle(GetWorld(), TraceStart, TraceEnd, TraceType, true, TArray<AActor*>(), EDrawDebugTrace::ForOneFrame, HitResult, true))
-	{
-		Result = (TraceEnd.Z - HitResult.Location.Z) / IKScale;
+	FootIKSubsystem->RequestTrace(this, TraceIndex, TraceStart, TraceEnd);
+}
 
-	}
-	else if (UKismetSystemLibrary::LineTraceSingle(GetWorld(), TraceEnd, TraceEnd - IKTraceExtendDistance * FVector::UpVector, TraceType, true, TArray<AActor*>(), EDrawDebugTrace::ForOneFrame, HitResult, true))
+float ASpiderPawn::GetIKOffsetForTrace(UFootIKSubsystem* FootIKSubsystem, int32 TraceIndex) const
+{
+	float Result = 0.0f;
+
+	FVector TraceStart;
+	FVector HitLocation;
+	if (FootIKSubsystem->GetTraceResult(this, TraceIndex, TraceStart, HitLocation))
 	{
-		Result = (TraceEnd.Z - HitResult.Location.Z) / IKScale;
+		float FootTraceEndZ = TraceStart.Z - IKTraceDistance;
+		Result = (FootTraceEndZ - HitLocation.Z) / IKScale;
 
 	}
 
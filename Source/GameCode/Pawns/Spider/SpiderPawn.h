@@ -6,6 +6,7 @@
 #include "GameCodeBasePawn.h"
 #include "SpiderPawn.generated.h"
 
+class UFootIKSubsystem;
 
 UCLASS()
 class GAMECODE_API ASpiderPawn : public AGameCodeBasePawn
@@ -17,6 +18,7 @@ public:
 	ASpiderPawn();
 
 	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	FORCEINLINE float GetIKRightFrontFootOffset() const { return IKRightFrontFootOffset;}
@@ -55,7 +57,8 @@ protected:
 
 private:
 	
-	float GetIKOffsetForASosket(const FName& SocketName);
+	void RequestIKTrace(UFootIKSubsystem* FootIKSubsystem, int32 TraceIndex, const FName& SocketName) const;
+	float GetIKOffsetForTrace(UFootIKSubsystem* FootIKSubsystem, int32 TraceIndex) const;
 
 	float IKRightFrontFootOffset = 0.0f;
 	float IKRightRearFootOffset = 0.0f;
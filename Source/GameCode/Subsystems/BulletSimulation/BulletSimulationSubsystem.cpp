@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/BulletSimulation/BulletSimulationSubsystem.h"
+#include "Components/Weapon/WeaponBarellComponent.h"
+#include "GameCodeTypes.h"
+#include "DrawDebugHelpers.h"
+#include "Kismet/GameplayStatics.h"
+#include "Subsystems/DebugSubsystem.h"
+
+DEFINE_LOG_CATEGORY(LogBulletSimulationSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("Bullet Simulation Tick"), STAT_BulletSimulationTick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Bullets"), STAT_SimulatedBullets, STATGROUP_Game);
+
+void UBulletSimulationSubsystem::Deinitialize()
+{
+	Locations.Empty();
+	SpawnLocations.Empty();
+	Velocities.Empty();
+	GravityZs.Empty();
+	LifeTimes.Empty();
+	Barells.Empty();
+	TraceHandles.Empty();
+
+	Super::Deinitialize();
+}
+
+void UBulletSimulationSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BulletSimulationTick);
+
+	ProcessTraceResults();
+	StepBullets(DeltaTime);
+
+	SET_DWORD_STAT(STAT_SimulatedBullets, Locations.Num());
+}
+
+ETickableTickType UBulletSimulationSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UBulletSimulationSubsystem::IsTickable() const
+{
+	return Locations.Num() > 0;
+}
+
+TStatId UBulletSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBulletSimulationSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UBulletSimulationSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+bool UBulletSimulationSubsystem::SpawnBullet(UWeaponBarellComponent* Barell, const FVector& Location, const FVector& Velocity, float GravityZ, float LifeTime)
+{
+	if (Locations.Num() >= MaxBullets)
+	{
+		UE_LOG(LogBulletSimulationSubsystem, Warning, TEXT("UBulletSimulationSubsystem::SpawnBullet(): %s, Too many bullets, MaxBullets: %i"), *GetNameSafe(this), MaxBullets);
+		return false;
+	}
+
+	Locations.Add(Location);
+	SpawnLocations.Add(Location);
+	Velocities.Add(Velocity);
+	GravityZs.Add(GravityZ);
+	LifeTimes.Add(LifeTime);
+	Barells.Add(Barell);
+	TraceHandles.AddDefaulted();
+
+	return true;
+}
+
+int32 UBulletSimulationSubsystem::GetBulletCount() const
+{
+	return Locations.Num();
+}
+
+void UBulletSimulationSubsystem::ProcessTraceResults()
+{
+	UWorld* World = GetWorld();
+
+	FTraceDatum TraceDatum;
+	for (int32 i = Locations.Num() - 1; i >= 0; --i)
+	{
+		// Trace result is available only in the frame after it was requested.
+		if (!TraceHandles[i].IsValid() || !World->QueryTraceData(TraceHandles[i], TraceDatum))
+		{
+			continue;
+		}
+
+		const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& HitResult) { return HitResult.bBlockingHit; });
+		if (BlockingHit == nullptr)
+		{
+			continue;
+		}
+
+		// Hit handling can change bullets, so the bullet is removed before it.
+		const TWeakObjectPtr<UWeaponBarellComponent> Barell = Barells[i];
+		const FVector SpawnLocation = SpawnLocations[i];
+		const FVector Direction = (TraceDatum.End - TraceDatum.Start).GetSafeNormal();
+		const FHitResult HitResult = *BlockingHit;
+		RemoveBullet(i);
+
+		if (Barell.IsValid())
+		{
+			Barell->ProcessSimulatedBulletHit(HitResult, Direction, SpawnLocation);
+		}
+	}
+}
+
+void UBulletSimulationSubsystem::StepBullets(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+
+#if ENABLE_DRAW_DEBUG
+	UDebugSubsystem* DebugSubSystem = UGameplayStatics::GetGameInstance(World)->GetSubsystem<UDebugSubsystem>();
+	bool bIsDebugEnabled = DebugSubSystem->IsCategoryEnabled(DebugCategoryRangeWeapon);
+#else
+	bool bIsDebugEnabled = false;
+#endif
+
+	for (int32 i = Locations.Num() - 1; i >= 0; --i)
+	{
+		LifeTimes[i] -= DeltaTime;
+		if (LifeTimes[i] <= 0.0f || !Barells[i].IsValid())
+		{
+			RemoveBullet(i);
+			continue;
+		}
+
+		const FVector StepStart = Locations[i];
+		const FVector Gravity(0.0f, 0.0f, GravityZs[i]);
+		Locations[i] += Velocities[i] * DeltaTime + 0.5f * Gravity * DeltaTime * DeltaTime;
+		Velocities[i] += Gravity * DeltaTime;
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SimulatedBullet));
+		QueryParams.AddIgnoredActor(Barells[i]->GetOwner());
+		TraceHandles[i] = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, StepStart, Locations[i], ECC_Bullet, QueryParams);
+
+		if (bIsDebugEnabled)
+		{
+			DrawDebugLine(World, StepStart, Locations[i], FColor::Orange, false, 1.0f, 0, 2.0f);
+		}
+	}
+}
+
+void UBulletSimulationSubsystem::RemoveBullet(int32 Index)
+{
+	Locations.RemoveAtSwap(Index, 1, false);
+	SpawnLocations.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	GravityZs.RemoveAtSwap(Index, 1, false);
+	LifeTimes.RemoveAtSwap(Index, 1, false);
+	Barells.RemoveAtSwap(Index, 1, false);
+	TraceHandles.RemoveAtSwap(Index, 1, false);
+}
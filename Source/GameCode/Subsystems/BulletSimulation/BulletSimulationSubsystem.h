@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+#include "BulletSimulationSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBulletSimulationSubsystem, Log, All);
+
+class UWeaponBarellComponent;
+
+/**
+ * Simulates bullets without actors. Bullets are stored as arrays of their attributes and stepped together,
+ * segments of all bullets are traced asynchronously and hits are delivered to the barrel next frame.
+ */
+UCLASS(Config = Game)
+class GAMECODE_API UBulletSimulationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** Returns false if there are @MaxBullets bullets already */
+	bool SpawnBullet(UWeaponBarellComponent* Barell, const FVector& Location, const FVector& Velocity, float GravityZ, float LifeTime);
+
+	int32 GetBulletCount() const;
+
+private:
+	void ProcessTraceResults();
+	void StepBullets(float DeltaTime);
+	void RemoveBullet(int32 Index);
+
+	TArray<FVector> Locations;
+	/** Falloff of the hit damage is computed from them, muzzle can move while the bullet flies */
+	TArray<FVector> SpawnLocations;
+	TArray<FVector> Velocities;
+	TArray<float> GravityZs;
+	TArray<float> LifeTimes;
+	TArray<TWeakObjectPtr<UWeaponBarellComponent>> Barells;
+	/** Trace of the last step of the bullet */
+	TArray<FTraceHandle> TraceHandles;
+
+	UPROPERTY(Config)
+	int32 MaxBullets = 4096;
+
+};
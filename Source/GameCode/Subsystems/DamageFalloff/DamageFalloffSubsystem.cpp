@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/DamageFalloff/DamageFalloffSubsystem.h"
+#include "Curves/CurveFloat.h"
+
+DEFINE_LOG_CATEGORY(LogDamageFalloffSubsystem)
+
+void FDamageFalloffTable::Build(const UCurveFloat* Curve, int32 Resolution)
+{
+	Resolution = FMath::Max(Resolution, 2);
+
+	float MaxDistance = 0.0f;
+	Curve->GetTimeRange(MinDistance, MaxDistance);
+
+	const float Range = MaxDistance - MinDistance;
+	SampleRate = Range > KINDA_SMALL_NUMBER ? (Resolution - 1) / Range : 0.0f;
+
+	Samples.SetNumUninitialized(Resolution);
+	for (int32 i = 0; i < Resolution; ++i)
+	{
+		Samples[i] = Curve->GetFloatValue(MinDistance + Range * i / (Resolution - 1));
+	}
+}
+
+float FDamageFalloffTable::GetFalloff(float Distance) const
+{
+	const float Position = FMath::Clamp((Distance - MinDistance) * SampleRate, 0.0f, (float)(Samples.Num() - 1));
+	const int32 Index = FMath::Min((int32)Position, Samples.Num() - 2);
+
+	return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+}
+
+float FDamageFalloffTable::GetDamage(float BaseDamage, float Distance) const
+{
+	const float Falloff = GetFalloff(Distance);
+	return Falloff > 0.0f && BaseDamage > 0.0f ? BaseDamage + Falloff * BaseDamage : BaseDamage;
+}
+
+void UDamageFalloffSubsystem::Deinitialize()
+{
+	FalloffTables.Empty();
+
+	Super::Deinitialize();
+}
+
+TSharedPtr<const FDamageFalloffTable> UDamageFalloffSubsystem::GetFalloffTable(const UCurveFloat* Curve)
+{
+	if (!IsValid(Curve))
+	{
+		return nullptr;
+	}
+
+	const TSharedRef<const FDamageFalloffTable>* FalloffTable = FalloffTables.Find(Curve);
+	if (FalloffTable != nullptr)
+	{
+		return *FalloffTable;
+	}
+
+	TSharedRef<FDamageFalloffTable> NewFalloffTable = MakeShared<FDamageFalloffTable>();
+	NewFalloffTable->Build(Curve, FalloffTableResolution);
+	FalloffTables.Add(Curve, NewFalloffTable);
+
+	return NewFalloffTable;
+}
+
+void UDamageFalloffSubsystem::BenchmarkDamageFalloff(int32 HitsCount)
+{
+#if !UE_BUILD_SHIPPING
+	HitsCount = HitsCount > 0 ? HitsCount : 1000000;
+
+	// Falloff shaped like weapon curves: bonus damage up close, penalty far away.
+	UCurveFloat* Curve = NewObject<UCurveFloat>(GetTransientPackage());
+	Curve->FloatCurve.AddKey(0.0f, 0.5f);
+	Curve->FloatCurve.AddKey(1000.0f, 0.4f);
+	Curve->FloatCurve.AddKey(3000.0f, 0.1f);
+	Curve->FloatCurve.AddKey(6000.0f, -0.5f);
+	Curve->FloatCurve.AddKey(10000.0f, -0.7f);
+	for (FRichCurveKey& Key : Curve->FloatCurve.Keys)
+	{
+		Key.InterpMode = RCIM_Cubic;
+	}
+
+	FDamageFalloffTable FalloffTable;
+	FalloffTable.Build(Curve, FalloffTableResolution);
+
+	FRandomStream RandomStream(HitsCount);
+	TArray<float> Distances;
+	Distances.SetNumUninitialized(HitsCount);
+	for (float& Distance : Distances)
+	{
+		Distance = RandomStream.FRandRange(0.0f, 12000.0f);
+	}
+
+	const float BaseDamage = 20.0f;
+
+	double StartTime = FPlatformTime::Seconds();
+	double CurveDamageSum = 0.0;
+	for (const float Distance : Distances)
+	{
+		const float Falloff = Curve->GetFloatValue(Distance);
+		CurveDamageSum += Falloff > 0.0f ? BaseDamage + Falloff * BaseDamage : BaseDamage;
+	}
+	const double CurveTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	double TableDamageSum = 0.0;
+	for (const float Distance : Distances)
+	{
+		TableDamageSum += FalloffTable.GetDamage(BaseDamage, Distance);
+	}
+	const double TableTime = FPlatformTime::Seconds() - StartTime;
+
+	float MaxError = 0.0f;
+	for (int32 i = 0; i < FMath::Min(HitsCount, 10000); ++i)
+	{
+		MaxError = FMath::Max(MaxError, FMath::Abs(Curve->GetFloatValue(Distances[i]) - FalloffTable.GetFalloff(Distances[i])));
+	}
+
+	UE_LOG(LogDamageFalloffSubsystem, Display, TEXT("UDamageFalloffSubsystem::BenchmarkDamageFalloff(): Hits %i, Curve %.3f ms (%.1f Mhits/s, sum %.1f), Table %.3f ms (%.1f Mhits/s, sum %.1f), Resolution %i, Max falloff error %.5f"),
+		HitsCount,
+		CurveTime * 1000.0, HitsCount / FMath::Max(CurveTime, SMALL_NUMBER) / 1000000.0, CurveDamageSum,
+		TableTime * 1000.0, HitsCount / FMath::Max(TableTime, SMALL_NUMBER) / 1000000.0, TableDamageSum,
+		FalloffTable.GetResolution(), MaxError);
+#endif
+}
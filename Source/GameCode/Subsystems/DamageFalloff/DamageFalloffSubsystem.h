@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "DamageFalloffSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDamageFalloffSubsystem, Log, All);
+
+class UCurveFloat;
+
+/**
+ * Falloff curve sampled with fixed resolution over its time range. Distances outside of the range are clamped.
+ */
+struct FDamageFalloffTable
+{
+public:
+	void Build(const UCurveFloat* Curve, int32 Resolution);
+
+	/** Curve value at @Distance, linearly interpolated between samples */
+	float GetFalloff(float Distance) const;
+
+	/** Damage of a hit at @Distance, falloff scales @BaseDamage the same way as the curve did */
+	float GetDamage(float BaseDamage, float Distance) const;
+
+	int32 GetResolution() const { return Samples.Num(); }
+
+private:
+	TArray<float> Samples;
+	float MinDistance = 0.0f;
+	/** Samples per distance unit */
+	float SampleRate = 0.0f;
+};
+
+/**
+ * Falloff tables shared by all weapons that use the same curve. Tables are built on first request and kept for the game.
+ */
+UCLASS(Config = Game)
+class GAMECODE_API UDamageFalloffSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Table of @Curve, builds it if needed. Returns nullptr if there is no curve. */
+	TSharedPtr<const FDamageFalloffTable> GetFalloffTable(const UCurveFloat* Curve);
+
+private:
+	/** Compares throughput of curve evaluation and table lookup for @HitsCount hits, 1M hits if it is not set. */
+	UFUNCTION(Exec)
+	void BenchmarkDamageFalloff(int32 HitsCount);
+
+	TMap<TWeakObjectPtr<const UCurveFloat>, TSharedRef<const FDamageFalloffTable>> FalloffTables;
+
+	/** Number of samples of every table */
+	UPROPERTY(Config)
+	int32 FalloffTableResolution = 256;
+
+};
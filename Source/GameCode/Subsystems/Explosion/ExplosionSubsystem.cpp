@@ -0,0 +1,316 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Explosion/ExplosionSubsystem.h"
+#include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/Controller.h"
+
+DEFINE_LOG_CATEGORY(LogExplosionSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("Explosion Tick"), STAT_ExplosionTick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Explosions"), STAT_PendingExplosions, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Overlap Queries"), STAT_ExplosionOverlapQueries, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Occlusion Traces"), STAT_ExplosionOcclusionTraces, STATGROUP_Game);
+
+void UExplosionSubsystem::Deinitialize()
+{
+	PendingExplosions.Empty();
+
+	Super::Deinitialize();
+}
+
+void UExplosionSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ExplosionTick);
+
+	ProcessTraceResults();
+	GatherTargets();
+	RequestTraces();
+
+	// Damage handlers can queue new explosions, so finished explosions are removed before damage is applied.
+	TArray<FPendingExplosion> FinishedExplosions;
+	for (int32 i = 0; i < PendingExplosions.Num(); ++i)
+	{
+		const FPendingExplosion& Explosion = PendingExplosions[i];
+		if (Explosion.bAreTargetsGathered && !Explosion.Targets.ContainsByPredicate([](const FExplosionTarget& Target) { return !Target.bIsTraced; }))
+		{
+			FinishedExplosions.Add(MoveTemp(PendingExplosions[i]));
+			PendingExplosions.RemoveAt(i--);
+		}
+	}
+
+	for (const FPendingExplosion& Explosion : FinishedExplosions)
+	{
+		ApplyDamage(Explosion);
+	}
+
+	SET_DWORD_STAT(STAT_PendingExplosions, PendingExplosions.Num());
+}
+
+ETickableTickType UExplosionSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UExplosionSubsystem::IsTickable() const
+{
+	return PendingExplosions.Num() > 0;
+}
+
+TStatId UExplosionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UExplosionSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UExplosionSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UExplosionSubsystem::QueueExplosion(const FExplosionParams& Params)
+{
+	FPendingExplosion& Explosion = PendingExplosions.AddDefaulted_GetRef();
+	Explosion.Params = Params;
+}
+
+void UExplosionSubsystem::ExplosionStats()
+{
+#if !UE_BUILD_SHIPPING
+	int32 GatheredCount = 0;
+	int32 PendingTracesCount = 0;
+	for (const FPendingExplosion& Explosion : PendingExplosions)
+	{
+		GatheredCount += Explosion.bAreTargetsGathered ? 1 : 0;
+		for (const FExplosionTarget& Target : Explosion.Targets)
+		{
+			PendingTracesCount += Target.bIsTraced ? 0 : 1;
+		}
+	}
+
+	UE_LOG(LogExplosionSubsystem, Display, TEXT("UExplosionSubsystem::ExplosionStats(): %i explosions (%i gathered), %i targets waiting for traces"), PendingExplosions.Num(), GatheredCount, PendingTracesCount);
+#endif
+}
+
+void UExplosionSubsystem::ProcessTraceResults()
+{
+	UWorld* World = GetWorld();
+
+	FTraceDatum TraceDatum;
+	for (FPendingExplosion& Explosion : PendingExplosions)
+	{
+		for (FExplosionTarget& Target : Explosion.Targets)
+		{
+			if (Target.bIsTraced || !Target.TraceHandle.IsValid())
+			{
+				continue;
+			}
+
+			// Trace result is available only in the frame after it was requested, a lost result is traced again.
+			if (!World->QueryTraceData(Target.TraceHandle, TraceDatum))
+			{
+				TraceTarget(Explosion.Params, Target, false);
+				continue;
+			}
+
+			const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& HitResult) { return HitResult.bBlockingHit; });
+			SetTraceResult(Target, Explosion.Params, BlockingHit);
+		}
+	}
+}
+
+void UExplosionSubsystem::GatherTargets()
+{
+	TArray<int32> NewExplosions;
+	for (int32 i = 0; i < PendingExplosions.Num() && NewExplosions.Num() < MaxExplosionsPerFrame; ++i)
+	{
+		if (!PendingExplosions[i].bAreTargetsGathered)
+		{
+			NewExplosions.Add(i);
+		}
+	}
+
+	int32 OverlapQueriesCount = 0;
+	TArray<int32> GroupExplosions;
+	while (NewExplosions.Num() > 0)
+	{
+		// Explosions that fit into bounds of the oldest one share its query.
+		GroupExplosions.Reset();
+		GroupExplosions.Add(NewExplosions[0]);
+		FBox GroupBounds = GetExplosionBounds(PendingExplosions[NewExplosions[0]].Params);
+		NewExplosions.RemoveAt(0);
+
+		for (int32 i = 0; i < NewExplosions.Num(); ++i)
+		{
+			const FBox MergedBounds = GroupBounds + GetExplosionBounds(PendingExplosions[NewExplosions[i]].Params);
+			if (MergedBounds.GetSize().GetMax() <= MaxSharedQuerySize)
+			{
+				GroupBounds = MergedBounds;
+				GroupExplosions.Add(NewExplosions[i]);
+				NewExplosions.RemoveAt(i--);
+			}
+		}
+
+		GatherGroupTargets(GroupExplosions, GroupBounds);
+		++OverlapQueriesCount;
+	}
+
+	SET_DWORD_STAT(STAT_ExplosionOverlapQueries, OverlapQueriesCount);
+}
+
+void UExplosionSubsystem::GatherGroupTargets(const TArray<int32>& GroupExplosions, const FBox& GroupBounds)
+{
+	TArray<FOverlapResult> Overlaps;
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ExplosionOverlap), false);
+	GetWorld()->OverlapMultiByObjectType(Overlaps, GroupBounds.GetCenter(), FQuat::Identity, FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects), FCollisionShape::MakeBox(GroupBounds.GetExtent()), QueryParams);
+
+	for (const int32 ExplosionIndex : GroupExplosions)
+	{
+		FPendingExplosion& Explosion = PendingExplosions[ExplosionIndex];
+		const FExplosionParams& Params = Explosion.Params;
+		const FCollisionShape ExplosionShape = FCollisionShape::MakeSphere(Params.OuterRadius);
+
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			UPrimitiveComponent* Component = Overlap.GetComponent();
+			AActor* OverlapActor = Overlap.GetActor();
+			if (!IsValid(Component) || !IsValid(OverlapActor) || !OverlapActor->CanBeDamaged() || OverlapActor == Params.IgnoredActor.Get() || OverlapActor == Params.DamageCauser.Get())
+			{
+				continue;
+			}
+
+			// Shared query is a box, each explosion checks its own sphere against the component.
+			if (!Component->OverlapComponent(Params.Origin, FQuat::Identity, ExplosionShape))
+			{
+				continue;
+			}
+
+			FExplosionTarget& Target = Explosion.Targets.AddDefaulted_GetRef();
+			Target.Component = Component;
+		}
+
+		Explosion.bAreTargetsGathered = true;
+	}
+}
+
+void UExplosionSubsystem::RequestTraces()
+{
+	int32 TracesCount = 0;
+	for (FPendingExplosion& Explosion : PendingExplosions)
+	{
+		if (!Explosion.bAreTargetsGathered)
+		{
+			continue;
+		}
+
+		while (Explosion.NextTraceIndex < Explosion.Targets.Num() && TracesCount < MaxTracesPerFrame)
+		{
+			TraceTarget(Explosion.Params, Explosion.Targets[Explosion.NextTraceIndex++], bUseAsyncOcclusionTraces);
+			++TracesCount;
+		}
+
+		if (TracesCount >= MaxTracesPerFrame)
+		{
+			break;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ExplosionOcclusionTraces, TracesCount);
+}
+
+void UExplosionSubsystem::TraceTarget(const FExplosionParams& Params, FExplosionTarget& Target, bool bIsAsync)
+{
+	UPrimitiveComponent* Component = Target.Component.Get();
+	if (!IsValid(Component))
+	{
+		Target.bIsTraced = true;
+		Target.bIsVisible = false;
+		return;
+	}
+
+	// Same trace as ApplyRadialDamage does: from the origin to the component bounds.
+	const FVector TraceEnd = Component->Bounds.Origin;
+	FVector TraceStart = Params.Origin;
+	if (TraceStart == TraceEnd)
+	{
+		TraceStart.Z += 0.01f;
+	}
+
+	if (bIsAsync)
+	{
+		Target.TraceHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, ECC_Visibility, GetTraceParams(Params));
+		return;
+	}
+
+	FHitResult HitResult;
+	const bool bHasHit = GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility, GetTraceParams(Params));
+	SetTraceResult(Target, Params, bHasHit ? &HitResult : nullptr);
+}
+
+void UExplosionSubsystem::SetTraceResult(FExplosionTarget& Target, const FExplosionParams& Params, const FHitResult* BlockingHit) const
+{
+	Target.bIsTraced = true;
+	Target.TraceHandle = FTraceHandle();
+
+	UPrimitiveComponent* Component = Target.Component.Get();
+	if (!IsValid(Component))
+	{
+		Target.bIsVisible = false;
+		return;
+	}
+
+	if (BlockingHit != nullptr)
+	{
+		Target.bIsVisible = BlockingHit->Component == Component;
+		Target.HitResult = *BlockingHit;
+		return;
+	}
+
+	// Nothing is blocking, the component is hit at its location.
+	const FVector FakeHitLocation = Component->GetComponentLocation();
+	Target.bIsVisible = true;
+	Target.HitResult = FHitResult(Component->GetOwner(), Component, FakeHitLocation, (Params.Origin - FakeHitLocation).GetSafeNormal());
+}
+
+void UExplosionSubsystem::ApplyDamage(const FPendingExplosion& Explosion) const
+{
+	const FExplosionParams& Params = Explosion.Params;
+
+	TMap<AActor*, TArray<FHitResult>> ActorHits;
+	for (const FExplosionTarget& Target : Explosion.Targets)
+	{
+		AActor* TargetActor = Target.bIsVisible && Target.Component.IsValid() ? Target.Component->GetOwner() : nullptr;
+		if (IsValid(TargetActor))
+		{
+			ActorHits.FindOrAdd(TargetActor).Add(Target.HitResult);
+		}
+	}
+
+	FRadialDamageEvent DamageEvent;
+	DamageEvent.DamageTypeClass = Params.DamageTypeClass != nullptr ? Params.DamageTypeClass : TSubclassOf<UDamageType>(UDamageType::StaticClass());
+	DamageEvent.Origin = Params.Origin;
+	DamageEvent.Params = FRadialDamageParams(Params.MaxDamage, Params.MinDamage, Params.InnerRadius, Params.OuterRadius, Params.DamageFalloff);
+
+	for (TPair<AActor*, TArray<FHitResult>>& ActorHit : ActorHits)
+	{
+		// Previous damage of this explosion can destroy actors.
+		if (!IsValid(ActorHit.Key))
+		{
+			continue;
+		}
+
+		DamageEvent.ComponentHits = MoveTemp(ActorHit.Value);
+		ActorHit.Key->TakeDamage(Params.MaxDamage, DamageEvent, Params.InstigatorController.Get(), Params.DamageCauser.Get());
+	}
+}
+
+FCollisionQueryParams UExplosionSubsystem::GetTraceParams(const FExplosionParams& Params) const
+{
+	return FCollisionQueryParams(SCENE_QUERY_STAT(ExplosionOcclusion), true, Params.IgnoredActor.Get());
+}
+
+FBox UExplosionSubsystem::GetExplosionBounds(const FExplosionParams& Params)
+{
+	return FBox::BuildAABB(Params.Origin, FVector(Params.OuterRadius));
+}
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+#include "ExplosionSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogExplosionSubsystem, Log, All);
+
+class UDamageType;
+
+/** Radial damage of one detonation, same parameters as ApplyRadialDamageWithFalloff */
+struct FExplosionParams
+{
+	FVector Origin = FVector::ZeroVector;
+	float MaxDamage = 0.0f;
+	float MinDamage = 0.0f;
+	float InnerRadius = 0.0f;
+	float OuterRadius = 0.0f;
+	float DamageFalloff = 1.0f;
+	TSubclassOf<UDamageType> DamageTypeClass;
+	TWeakObjectPtr<AActor> IgnoredActor;
+	TWeakObjectPtr<AActor> DamageCauser;
+	TWeakObjectPtr<AController> InstigatorController;
+};
+
+/** Component in the explosion radius waiting for its occlusion trace */
+struct FExplosionTarget
+{
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+	FTraceHandle TraceHandle;
+	FHitResult HitResult;
+	bool bIsTraced = false;
+	bool bIsVisible = false;
+};
+
+struct FPendingExplosion
+{
+	FExplosionParams Params;
+	TArray<FExplosionTarget> Targets;
+	/** Targets before this index have their traces requested */
+	int32 NextTraceIndex = 0;
+	bool bAreTargetsGathered = false;
+};
+
+/**
+ * Applies radial damage of queued explosions. Explosions close to each other share one overlap query,
+ * occlusion traces are batched and can be async. Work over per-frame budgets is carried to the next frames.
+ */
+UCLASS(Config = Game)
+class GAMECODE_API UExplosionSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** Damage is applied in one of the next frames, when all targets of the explosion are traced */
+	void QueueExplosion(const FExplosionParams& Params);
+
+	/** Logs queued explosions and targets waiting for traces. */
+	UFUNCTION(Exec)
+	void ExplosionStats();
+
+private:
+	void ProcessTraceResults();
+	void GatherTargets();
+	void GatherGroupTargets(const TArray<int32>& GroupExplosions, const FBox& GroupBounds);
+	void RequestTraces();
+	void TraceTarget(const FExplosionParams& Params, FExplosionTarget& Target, bool bIsAsync);
+	void SetTraceResult(FExplosionTarget& Target, const FExplosionParams& Params, const FHitResult* BlockingHit) const;
+	void ApplyDamage(const FPendingExplosion& Explosion) const;
+	FCollisionQueryParams GetTraceParams(const FExplosionParams& Params) const;
+	static FBox GetExplosionBounds(const FExplosionParams& Params);
+
+	/** Oldest first */
+	TArray<FPendingExplosion> PendingExplosions;
+
+	/** Max number of explosions that gather targets in one frame */
+	UPROPERTY(Config)
+	int32 MaxExplosionsPerFrame = 8;
+
+	/** Max number of occlusion traces requested in one frame */
+	UPROPERTY(Config)
+	int32 MaxTracesPerFrame = 128;
+
+	/** Explosions of one frame share an overlap query while the size of their bounds is not bigger than this */
+	UPROPERTY(Config)
+	float MaxSharedQuerySize = 4000.0f;
+
+	/** Occlusion traces run on worker threads and are processed next frame */
+	UPROPERTY(Config)
+	bool bUseAsyncOcclusionTraces = true;
+
+};
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/FireScheduler/FireSchedulerSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Fire Scheduler Tick"), STAT_FireSchedulerTick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduled Fires"), STAT_ScheduledFires, STATGROUP_Game);
+
+void UFireSchedulerSubsystem::Deinitialize()
+{
+	ScheduledFires.Empty();
+
+	Super::Deinitialize();
+}
+
+void UFireSchedulerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FireSchedulerTick);
+
+	// Shot callbacks can start and stop fire, so entries are accessed by index and removed after the loop.
+	const int32 ScheduledFiresCount = ScheduledFires.Num();
+	for (int32 i = 0; i < ScheduledFiresCount; ++i)
+	{
+		if (ScheduledFires[i].bIsStopped)
+		{
+			continue;
+		}
+
+		ScheduledFires[i].TimeToNextShot -= DeltaTime;
+
+		int32 ShotsCount = 0;
+		while (!ScheduledFires[i].bIsStopped && ScheduledFires[i].TimeToNextShot <= 0.0f)
+		{
+			if (ShotsCount++ >= MaxShotsPerFrame)
+			{
+				ScheduledFires[i].TimeToNextShot = 0.0f;
+				break;
+			}
+
+			const float ShotTimeOffset = -ScheduledFires[i].TimeToNextShot;
+			ScheduledFires[i].TimeToNextShot += ScheduledFires[i].Interval;
+
+			const FOnScheduledShot OnScheduledShot = ScheduledFires[i].OnScheduledShot;
+			if (!OnScheduledShot.IsBound() || !OnScheduledShot.Execute(ShotTimeOffset))
+			{
+				ScheduledFires[i].bIsStopped = true;
+			}
+		}
+	}
+
+	ScheduledFires.RemoveAll([](const FScheduledFire& ScheduledFire) { return ScheduledFire.bIsStopped || !ScheduledFire.Shooter.IsValid(); });
+
+	SET_DWORD_STAT(STAT_ScheduledFires, ScheduledFires.Num());
+}
+
+ETickableTickType UFireSchedulerSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UFireSchedulerSubsystem::IsTickable() const
+{
+	return ScheduledFires.Num() > 0;
+}
+
+TStatId UFireSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFireSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UFireSchedulerSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UFireSchedulerSubsystem::StartFire(const UObject* Shooter, float Interval, float FirstShotDelay, const FOnScheduledShot& OnScheduledShot)
+{
+	StopFire(Shooter);
+
+	FScheduledFire& ScheduledFire = ScheduledFires.AddDefaulted_GetRef();
+	ScheduledFire.Shooter = Shooter;
+	ScheduledFire.OnScheduledShot = OnScheduledShot;
+	ScheduledFire.Interval = FMath::Max(Interval, KINDA_SMALL_NUMBER);
+	ScheduledFire.TimeToNextShot = FirstShotDelay;
+}
+
+void UFireSchedulerSubsystem::StopFire(const UObject* Shooter)
+{
+	const int32 ScheduledFireIndex = FindScheduledFire(Shooter);
+	if (ScheduledFireIndex != INDEX_NONE)
+	{
+		ScheduledFires[ScheduledFireIndex].bIsStopped = true;
+	}
+}
+
+bool UFireSchedulerSubsystem::IsFireScheduled(const UObject* Shooter) const
+{
+	return FindScheduledFire(Shooter) != INDEX_NONE;
+}
+
+int32 UFireSchedulerSubsystem::FindScheduledFire(const UObject* Shooter) const
+{
+	return ScheduledFires.IndexOfByPredicate([Shooter](const FScheduledFire& ScheduledFire) { return !ScheduledFire.bIsStopped && ScheduledFire.Shooter == Shooter; });
+}
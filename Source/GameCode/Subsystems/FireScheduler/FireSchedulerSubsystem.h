@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FireSchedulerSubsystem.generated.h"
+
+/** Called for every shot that is due. Param: seconds since the shot was due in this frame. Return false to stop firing. */
+DECLARE_DELEGATE_RetVal_OneParam(bool, FOnScheduledShot, float);
+
+struct FScheduledFire
+{
+	TWeakObjectPtr<const UObject> Shooter;
+	FOnScheduledShot OnScheduledShot;
+	float Interval = 0.0f;
+	/** Negative when shots are owed */
+	float TimeToNextShot = 0.0f;
+	bool bIsStopped = false;
+};
+
+/**
+ * Fires all range weapons and turrets of the world. Elapsed time is accumulated per shooter,
+ * so every owed shot is fired even if the fire interval is shorter than a frame.
+ */
+UCLASS(Config = Game)
+class GAMECODE_API UFireSchedulerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** Calls @OnScheduledShot every @Interval seconds after @FirstShotDelay. Restarts fire of @Shooter if it is already scheduled. */
+	void StartFire(const UObject* Shooter, float Interval, float FirstShotDelay, const FOnScheduledShot& OnScheduledShot);
+	void StopFire(const UObject* Shooter);
+	bool IsFireScheduled(const UObject* Shooter) const;
+
+private:
+	int32 FindScheduledFire(const UObject* Shooter) const;
+
+	TArray<FScheduledFire> ScheduledFires;
+
+	/** Shots owed over this number in one frame are dropped, so a hitch doesn't empty the clip in one frame */
+	UPROPERTY(Config)
+	int32 MaxShotsPerFrame = 16;
+
+};
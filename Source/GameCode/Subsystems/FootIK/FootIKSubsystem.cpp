@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/FootIK/FootIKSubsystem.h"
+#include "GameCodeTypes.h"
+#include "DrawDebugHelpers.h"
+#include "Kismet/GameplayStatics.h"
+#include "Subsystems/DebugSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Foot IK Tick"), STAT_FootIKTick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Foot IK Traces"), STAT_FootIKTraces, STATGROUP_Game);
+
+void UFootIKSubsystem::Deinitialize()
+{
+	Requesters.Empty();
+
+	Super::Deinitialize();
+}
+
+void UFootIKSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FootIKTick);
+
+	UWorld* World = GetWorld();
+
+#if ENABLE_DRAW_DEBUG
+	UDebugSubsystem* DebugSubSystem = UGameplayStatics::GetGameInstance(World)->GetSubsystem<UDebugSubsystem>();
+	bool bIsDebugEnabled = DebugSubSystem->IsCategoryEnabled(DebugCategoryFootIK);
+#else
+	bool bIsDebugEnabled = false;
+#endif
+
+	int32 TracesCount = 0;
+	for (TMap<TWeakObjectPtr<const AActor>, FFootIKRequester>::TIterator RequesterIterator = Requesters.CreateIterator(); RequesterIterator; ++RequesterIterator)
+	{
+		const AActor* Requester = RequesterIterator.Key().Get();
+		if (!IsValid(Requester))
+		{
+			RequesterIterator.RemoveCurrent();
+			continue;
+		}
+
+		FFootIKRequester& FootIKRequester = RequesterIterator.Value();
+		FootIKRequester.TimeToNextTrace -= DeltaTime;
+		if (FootIKRequester.TimeToNextTrace > 0.0f)
+		{
+			continue;
+		}
+		FootIKRequester.TimeToNextTrace = FootIKRequester.TraceInterval;
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FootIK), true, Requester);
+		for (FFootIKTrace& Trace : FootIKRequester.Traces)
+		{
+			if (!Trace.bIsRequested)
+			{
+				continue;
+			}
+
+			// Result of the previous batch is kept until the new one is completed.
+			ProcessTraceResult(Trace);
+
+			Trace.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Trace.Start, Trace.End, ECC_Visibility, QueryParams);
+			Trace.bIsRequested = false;
+			++TracesCount;
+
+#if ENABLE_DRAW_DEBUG
+			if (bIsDebugEnabled)
+			{
+				DrawDebugLine(World, Trace.Start, Trace.End, FColor::Green, false, -1.0f, 0, 1.0f);
+				if (Trace.bHasHit)
+				{
+					DrawDebugPoint(World, Trace.HitLocation, 10.0f, FColor::Red);
+				}
+			}
+#endif
+		}
+	}
+
+	SET_DWORD_STAT(STAT_FootIKTraces, TracesCount);
+}
+
+ETickableTickType UFootIKSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UFootIKSubsystem::IsTickable() const
+{
+	return Requesters.Num() > 0;
+}
+
+TStatId UFootIKSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFootIKSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UFootIKSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+bool UFootIKSubsystem::IsTraceDue(const AActor* Requester) const
+{
+	const FFootIKRequester* FootIKRequester = Requesters.Find(Requester);
+	return FootIKRequester == nullptr || FootIKRequester->TimeToNextTrace <= GetWorld()->GetDeltaSeconds();
+}
+
+void UFootIKSubsystem::RequestTrace(const AActor* Requester, int32 TraceIndex, const FVector& Start, const FVector& End)
+{
+	check(TraceIndex >= 0);
+
+	FFootIKRequester& FootIKRequester = Requesters.FindOrAdd(Requester);
+	if (!FootIKRequester.Traces.IsValidIndex(TraceIndex))
+	{
+		FootIKRequester.Traces.SetNum(TraceIndex + 1);
+	}
+
+	FFootIKTrace& Trace = FootIKRequester.Traces[TraceIndex];
+	Trace.Start = Start;
+	Trace.End = End;
+	Trace.bIsRequested = true;
+}
+
+bool UFootIKSubsystem::GetTraceResult(const AActor* Requester, int32 TraceIndex, FVector& OutTraceStart, FVector& OutHitLocation)
+{
+	FFootIKRequester* FootIKRequester = Requesters.Find(Requester);
+	if (FootIKRequester == nullptr || !FootIKRequester->Traces.IsValidIndex(TraceIndex))
+	{
+		return false;
+	}
+
+	FFootIKTrace& Trace = FootIKRequester->Traces[TraceIndex];
+	ProcessTraceResult(Trace);
+
+	OutTraceStart = Trace.ResultStart;
+	OutHitLocation = Trace.HitLocation;
+	return Trace.bHasHit;
+}
+
+void UFootIKSubsystem::SetTraceInterval(const AActor* Requester, float TraceInterval)
+{
+	FFootIKRequester& FootIKRequester = Requesters.FindOrAdd(Requester);
+	FootIKRequester.TraceInterval = FMath::Max(TraceInterval, 0.0f);
+	FootIKRequester.TimeToNextTrace = FMath::Min(FootIKRequester.TimeToNextTrace, FootIKRequester.TraceInterval);
+}
+
+void UFootIKSubsystem::UnregisterRequester(const AActor* Requester)
+{
+	Requesters.Remove(Requester);
+}
+
+void UFootIKSubsystem::ProcessTraceResult(FFootIKTrace& Trace)
+{
+	FTraceDatum TraceDatum;
+	// Trace result is available only in the frame after it was requested.
+	if (!Trace.TraceHandle.IsValid() || !GetWorld()->QueryTraceData(Trace.TraceHandle, TraceDatum))
+	{
+		return;
+	}
+
+	Trace.TraceHandle = FTraceHandle();
+
+	const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& HitResult) { return HitResult.bBlockingHit; });
+	Trace.ResultStart = TraceDatum.Start;
+	Trace.bHasHit = BlockingHit != nullptr;
+	Trace.HitLocation = Trace.bHasHit ? BlockingHit->Location : FVector::ZeroVector;
+}
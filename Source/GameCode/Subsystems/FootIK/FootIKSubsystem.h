@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+#include "FootIKSubsystem.generated.h"
+
+struct FFootIKTrace
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	FTraceHandle TraceHandle;
+	bool bIsRequested = false;
+
+	/** Result of the last completed trace */
+	FVector ResultStart = FVector::ZeroVector;
+	FVector HitLocation = FVector::ZeroVector;
+	bool bHasHit = false;
+};
+
+struct FFootIKRequester
+{
+	TArray<FFootIKTrace, TInlineAllocator<4>> Traces;
+	/** Seconds between traces, 0 traces every frame */
+	float TraceInterval = 0.0f;
+	float TimeToNextTrace = 0.0f;
+};
+
+/**
+ * Foot IK traces of all characters. Traces requested during a frame are issued as one async batch at its end,
+ * results are available in the next frame.
+ */
+UCLASS()
+class GAMECODE_API UFootIKSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** True if traces of @Requester are issued at the end of this frame, so it's worth requesting them */
+	bool IsTraceDue(const AActor* Requester) const;
+
+	/** Trace @TraceIndex of @Requester is issued at the end of the frame if its trace interval has passed */
+	void RequestTrace(const AActor* Requester, int32 TraceIndex, const FVector& Start, const FVector& End);
+
+	/** Last completed trace @TraceIndex of @Requester. Returns false if it hasn't hit anything. */
+	bool GetTraceResult(const AActor* Requester, int32 TraceIndex, FVector& OutTraceStart, FVector& OutHitLocation);
+
+	void SetTraceInterval(const AActor* Requester, float TraceInterval);
+	void UnregisterRequester(const AActor* Requester);
+
+private:
+	void ProcessTraceResult(FFootIKTrace& Trace);
+
+	TMap<TWeakObjectPtr<const AActor>, FFootIKRequester> Requesters;
+
+};
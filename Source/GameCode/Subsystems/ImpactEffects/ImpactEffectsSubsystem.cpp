@@ -0,0 +1,316 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ImpactEffects/ImpactEffectsSubsystem.h"
+#include "Components/DecalComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraComponent.h"
+#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "GameFramework/PlayerController.h"
+
+DEFINE_LOG_CATEGORY(LogImpactEffectsSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("Impact Effects Tick"), STAT_ImpactEffectsTick, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Decals"), STAT_ImpactDecals, STATGROUP_Game);
+
+void UImpactEffectsSubsystem::Deinitialize()
+{
+	PendingDecals.Empty();
+	PendingEffects.Empty();
+	ActiveDecals.Empty();
+	FreeDecals.Empty();
+	AreaDecalCounts.Empty();
+
+	Super::Deinitialize();
+}
+
+void UImpactEffectsSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ImpactEffectsTick);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	ReleaseExpiredDecals(CurrentTime);
+
+	if (PendingDecals.Num() > 0 || PendingEffects.Num() > 0)
+	{
+		UpdateViewLocations();
+	}
+
+	for (const FImpactEffectRequest& Request : PendingDecals)
+	{
+		ProcessDecalRequest(Request, CurrentTime);
+	}
+	PendingDecals.Reset();
+
+	// Later effects of the frame are dropped, they are cosmetic.
+	const int32 EffectsCount = FMath::Min(PendingEffects.Num(), MaxEffectsPerFrame);
+	CulledEffectsCount += PendingEffects.Num() - EffectsCount;
+	for (int32 i = 0; i < EffectsCount; ++i)
+	{
+		ProcessEffectRequest(PendingEffects[i]);
+	}
+	PendingEffects.Reset();
+
+	SET_DWORD_STAT(STAT_ImpactDecals, ActiveDecals.Num());
+}
+
+ETickableTickType UImpactEffectsSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UImpactEffectsSubsystem::IsTickable() const
+{
+	return PendingDecals.Num() > 0 || PendingEffects.Num() > 0 || ActiveDecals.Num() > 0;
+}
+
+TStatId UImpactEffectsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UImpactEffectsSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UImpactEffectsSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UImpactEffectsSubsystem::SpawnDecal(const FDecalInfo& DecalInfo, const FVector& Location, const FRotator& Rotation)
+{
+	if (!CanSpawnEffects() || !IsValid(DecalInfo.DecalMaterial))
+	{
+		return;
+	}
+
+	FImpactEffectRequest& Request = PendingDecals.AddDefaulted_GetRef();
+	Request.DecalInfo = DecalInfo;
+	Request.Location = Location;
+	Request.Rotation = Rotation;
+	Request.Bounds = FBox(Location, Location);
+}
+
+void UImpactEffectsSubsystem::SpawnEffect(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation)
+{
+	if (!CanSpawnEffects() || !IsValid(System))
+	{
+		return;
+	}
+
+	FImpactEffectRequest& Request = PendingEffects.AddDefaulted_GetRef();
+	Request.System = System;
+	Request.Location = Location;
+	Request.Rotation = Rotation;
+	Request.Bounds = FBox(Location, Location);
+}
+
+void UImpactEffectsSubsystem::SpawnTraceEffect(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation, FName ParameterName, const FVector& TraceEnd)
+{
+	if (!CanSpawnEffects() || !IsValid(System))
+	{
+		return;
+	}
+
+	FImpactEffectRequest& Request = PendingEffects.AddDefaulted_GetRef();
+	Request.System = System;
+	Request.Location = Location;
+	Request.Rotation = Rotation;
+	Request.VectorParameter = ParameterName;
+	Request.VectorValue = TraceEnd;
+	Request.Bounds = FBox(Location, Location) + TraceEnd;
+}
+
+void UImpactEffectsSubsystem::SpawnMultiTraceEffect(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation, FName ParameterName, const TArray<FVector>& TraceEnds)
+{
+	if (!CanSpawnEffects() || !IsValid(System))
+	{
+		return;
+	}
+
+	FImpactEffectRequest& Request = PendingEffects.AddDefaulted_GetRef();
+	Request.System = System;
+	Request.Location = Location;
+	Request.Rotation = Rotation;
+	Request.ArrayParameter = ParameterName;
+	Request.ArrayValue = TraceEnds;
+	Request.Bounds = FBox(Location, Location);
+	for (const FVector& TraceEnd : TraceEnds)
+	{
+		Request.Bounds += TraceEnd;
+	}
+}
+
+void UImpactEffectsSubsystem::ImpactEffectsStats()
+{
+#if !UE_BUILD_SHIPPING
+	UE_LOG(LogImpactEffectsSubsystem, Display, TEXT("UImpactEffectsSubsystem::ImpactEffectsStats(): Decals: %i active, %i free, %i areas"), ActiveDecals.Num(), FreeDecals.Num(), AreaDecalCounts.Num());
+	UE_LOG(LogImpactEffectsSubsystem, Display, TEXT("UImpactEffectsSubsystem::ImpactEffectsStats(): Recycled decals: %i, culled decals: %i, culled effects: %i"), RecycledDecalsCount, CulledDecalsCount, CulledEffectsCount);
+#endif
+}
+
+bool UImpactEffectsSubsystem::CanSpawnEffects() const
+{
+	return GetWorld()->GetNetMode() != NM_DedicatedServer;
+}
+
+void UImpactEffectsSubsystem::UpdateViewLocations()
+{
+	ViewLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (IsValid(PlayerController) && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+}
+
+bool UImpactEffectsSubsystem::IsInViewRange(const FBox& Bounds, float MaxDistance) const
+{
+	// Without local viewers nothing can be culled safely.
+	if (ViewLocations.Num() == 0)
+	{
+		return true;
+	}
+
+	const float MaxDistanceSquared = FMath::Square(MaxDistance);
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		if (Bounds.ComputeSquaredDistanceToPoint(ViewLocation) <= MaxDistanceSquared)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UImpactEffectsSubsystem::ProcessDecalRequest(const FImpactEffectRequest& Request, float CurrentTime)
+{
+	if (MaxDecals <= 0 || !IsInViewRange(Request.Bounds, MaxDecalDistance))
+	{
+		++CulledDecalsCount;
+		return;
+	}
+
+	const FIntPoint Area = GetDecalArea(Request.Location);
+	const int32* AreaDecalCount = AreaDecalCounts.Find(Area);
+	if (AreaDecalCount != nullptr && *AreaDecalCount >= MaxDecalsPerArea)
+	{
+		const int32 OldestAreaDecalIndex = ActiveDecals.IndexOfByPredicate([Area](const FImpactDecal& Decal) { return Decal.Area == Area; });
+		if (OldestAreaDecalIndex != INDEX_NONE)
+		{
+			ReleaseDecal(OldestAreaDecalIndex);
+			++RecycledDecalsCount;
+		}
+	}
+	else if (ActiveDecals.Num() >= MaxDecals)
+	{
+		ReleaseDecal(0);
+		++RecycledDecalsCount;
+	}
+
+	UDecalComponent* DecalComponent = AcquireDecalComponent();
+	if (!IsValid(DecalComponent))
+	{
+		return;
+	}
+
+	DecalComponent->SetDecalMaterial(Request.DecalInfo.DecalMaterial);
+	DecalComponent->DecalSize = Request.DecalInfo.DecalSize;
+	DecalComponent->SetWorldLocationAndRotation(Request.Location, Request.Rotation);
+	DecalComponent->SetVisibility(true);
+	// Fade out is restarted on reuse. Decal is returned to the pool by the subsystem instead of the life span timer.
+	DecalComponent->SetFadeOut(Request.DecalInfo.DecalLifeTime, Request.DecalInfo.DecalFadeOutTime, false);
+	DecalComponent->SetLifeSpan(0.0f);
+
+	FImpactDecal& Decal = ActiveDecals.AddDefaulted_GetRef();
+	Decal.DecalComponent = DecalComponent;
+	Decal.ExpireTime = CurrentTime + Request.DecalInfo.DecalLifeTime + Request.DecalInfo.DecalFadeOutTime;
+	Decal.Area = Area;
+	++AreaDecalCounts.FindOrAdd(Area);
+}
+
+void UImpactEffectsSubsystem::ProcessEffectRequest(const FImpactEffectRequest& Request)
+{
+	if (!IsInViewRange(Request.Bounds, MaxEffectDistance))
+	{
+		++CulledEffectsCount;
+		return;
+	}
+
+	UNiagaraComponent* EffectComponent = UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), Request.System, Request.Location, Request.Rotation, FVector::OneVector, true, true, ENCPoolMethod::AutoRelease);
+	if (!IsValid(EffectComponent))
+	{
+		return;
+	}
+
+	if (Request.VectorParameter != NAME_None)
+	{
+		EffectComponent->SetVectorParameter(Request.VectorParameter, Request.VectorValue);
+	}
+
+	if (Request.ArrayParameter != NAME_None)
+	{
+		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(EffectComponent, Request.ArrayParameter, Request.ArrayValue);
+	}
+}
+
+void UImpactEffectsSubsystem::ReleaseExpiredDecals(float CurrentTime)
+{
+	// Decals with different life times can expire out of order.
+	for (int32 i = ActiveDecals.Num() - 1; i >= 0; --i)
+	{
+		if (ActiveDecals[i].ExpireTime <= CurrentTime || !IsValid(ActiveDecals[i].DecalComponent))
+		{
+			ReleaseDecal(i);
+		}
+	}
+}
+
+void UImpactEffectsSubsystem::ReleaseDecal(int32 DecalIndex)
+{
+	const FImpactDecal& Decal = ActiveDecals[DecalIndex];
+
+	int32* AreaDecalCount = AreaDecalCounts.Find(Decal.Area);
+	if (AreaDecalCount != nullptr && --(*AreaDecalCount) <= 0)
+	{
+		AreaDecalCounts.Remove(Decal.Area);
+	}
+
+	if (IsValid(Decal.DecalComponent))
+	{
+		Decal.DecalComponent->SetVisibility(false);
+		FreeDecals.Add(Decal.DecalComponent);
+	}
+
+	// Keeps the oldest decal first.
+	ActiveDecals.RemoveAt(DecalIndex);
+}
+
+UDecalComponent* UImpactEffectsSubsystem::AcquireDecalComponent()
+{
+	while (FreeDecals.Num() > 0)
+	{
+		UDecalComponent* DecalComponent = FreeDecals.Pop(false);
+		if (IsValid(DecalComponent))
+		{
+			return DecalComponent;
+		}
+	}
+
+	UDecalComponent* DecalComponent = NewObject<UDecalComponent>(GetWorld());
+	DecalComponent->bAllowAnyoneToDestroyMe = true;
+	DecalComponent->SetFadeScreenSize(0.0001f);
+	DecalComponent->RegisterComponentWithWorld(GetWorld());
+
+	return DecalComponent;
+}
+
+FIntPoint UImpactEffectsSubsystem::GetDecalArea(const FVector& Location) const
+{
+	const float AreaSize = FMath::Max(DecalAreaSize, 1.0f);
+	return FIntPoint(FMath::FloorToInt(Location.X / AreaSize), FMath::FloorToInt(Location.Y / AreaSize));
+}
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Components/Weapon/WeaponBarellComponent.h"
+#include "ImpactEffectsSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogImpactEffectsSubsystem, Log, All);
+
+class UDecalComponent;
+class UNiagaraSystem;
+
+USTRUCT()
+struct FImpactDecal
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UDecalComponent* DecalComponent = nullptr;
+
+	/** World time the decal is returned to the pool */
+	float ExpireTime = 0.0f;
+
+	FIntPoint Area = FIntPoint::ZeroValue;
+};
+
+/** Effect or decal waiting to be spawned at the end of the frame */
+struct FImpactEffectRequest
+{
+	UNiagaraSystem* System = nullptr;
+	FDecalInfo DecalInfo;
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	FName VectorParameter = NAME_None;
+	FVector VectorValue = FVector::ZeroVector;
+	FName ArrayParameter = NAME_None;
+	TArray<FVector> ArrayValue;
+
+	/** Bounds of the effect, used for distance culling */
+	FBox Bounds = FBox(ForceInit);
+};
+
+/**
+ * Spawns impact decals and weapon effects in one batch per frame.
+ * Decals are pooled and capped by global and per-area budgets, the oldest decal is recycled first.
+ * Niagara effects use the world Niagara component pool. Effects far from local viewers are culled.
+ */
+UCLASS(Config = Game)
+class GAMECODE_API UImpactEffectsSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	void SpawnDecal(const FDecalInfo& DecalInfo, const FVector& Location, const FRotator& Rotation);
+	void SpawnEffect(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation);
+	/** Effect with vector parameter @ParameterName set to @TraceEnd */
+	void SpawnTraceEffect(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation, FName ParameterName, const FVector& TraceEnd);
+	/** Effect with vector array parameter @ParameterName set to @TraceEnds */
+	void SpawnMultiTraceEffect(UNiagaraSystem* System, const FVector& Location, const FRotator& Rotation, FName ParameterName, const TArray<FVector>& TraceEnds);
+
+	/** Logs active and pooled decals and effects culled by budgets and distance. */
+	UFUNCTION(Exec)
+	void ImpactEffectsStats();
+
+private:
+	bool CanSpawnEffects() const;
+	void UpdateViewLocations();
+	bool IsInViewRange(const FBox& Bounds, float MaxDistance) const;
+
+	void ProcessDecalRequest(const FImpactEffectRequest& Request, float CurrentTime);
+	void ProcessEffectRequest(const FImpactEffectRequest& Request);
+	void ReleaseExpiredDecals(float CurrentTime);
+	void ReleaseDecal(int32 DecalIndex);
+	UDecalComponent* AcquireDecalComponent();
+	FIntPoint GetDecalArea(const FVector& Location) const;
+
+	TArray<FImpactEffectRequest> PendingDecals;
+	TArray<FImpactEffectRequest> PendingEffects;
+
+	/** Visible decals, oldest first */
+	UPROPERTY(Transient)
+	TArray<FImpactDecal> ActiveDecals;
+
+	UPROPERTY(Transient)
+	TArray<UDecalComponent*> FreeDecals;
+
+	TMap<FIntPoint, int32> AreaDecalCounts;
+	TArray<FVector> ViewLocations;
+
+	int32 RecycledDecalsCount = 0;
+	int32 CulledDecalsCount = 0;
+	int32 CulledEffectsCount = 0;
+
+	/** Max number of visible decals */
+	UPROPERTY(Config)
+	int32 MaxDecals = 256;
+
+	/** Max number of visible decals in one area */
+	UPROPERTY(Config)
+	int32 MaxDecalsPerArea = 32;
+
+	/** Size of the square area @MaxDecalsPerArea is applied to */
+	UPROPERTY(Config)
+	float DecalAreaSize = 500.0f;
+
+	/** Decals further from all local viewers are not spawned */
+	UPROPERTY(Config)
+	float MaxDecalDistance = 5000.0f;
+
+	/** Effects further from all local viewers are not spawned */
+	UPROPERTY(Config)
+	float MaxEffectDistance = 10000.0f;
+
+	/** Max number of Niagara effects spawned in one frame, the rest of the frame's effects are dropped */
+	UPROPERTY(Config)
+	int32 MaxEffectsPerFrame = 64;
+
+};
@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/LagCompensation/LagCompensationSubsystem.h"
+#include "Pawns/Character/GCBaseCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerState.h"
+
+DEFINE_LOG_CATEGORY(LogLagCompensationSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("Lag Compensation Record"), STAT_LagCompensationRecord, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Lag Compensation Rewind"), STAT_LagCompensationRewind, STATGROUP_Game);
+
+void ULagCompensationSubsystem::Deinitialize()
+{
+	Records.Empty();
+
+	Super::Deinitialize();
+}
+
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_LagCompensationRecord);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	for (int32 i = Records.Num() - 1; i >= 0; --i)
+	{
+		if (!Records[i].Character.IsValid())
+		{
+			Records.RemoveAtSwap(i);
+			continue;
+		}
+
+		RecordFrame(Records[i], CurrentTime);
+	}
+}
+
+ETickableTickType ULagCompensationSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool ULagCompensationSubsystem::IsTickable() const
+{
+	return Records.Num() > 0;
+}
+
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* ULagCompensationSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void ULagCompensationSubsystem::RegisterCharacter(AGCBaseCharacter* Character)
+{
+	if (!IsValid(Character) || !Character->HasAuthority() || GetWorld()->GetNetMode() == NM_Standalone)
+	{
+		return;
+	}
+
+	if (Records.ContainsByPredicate([Character](const FLagCompensationRecord& Record) { return Record.Character == Character; }))
+	{
+		return;
+	}
+
+	FLagCompensationRecord& Record = Records.AddDefaulted_GetRef();
+	Record.Character = Character;
+	ResetRecord(Record, GetBodyCount(Character));
+}
+
+void ULagCompensationSubsystem::UnregisterCharacter(AGCBaseCharacter* Character)
+{
+	const int32 RecordIndex = Records.IndexOfByPredicate([Character](const FLagCompensationRecord& Record) { return Record.Character == Character; });
+	if (RecordIndex != INDEX_NONE)
+	{
+		Records.RemoveAtSwap(RecordIndex);
+	}
+}
+
+void ULagCompensationSubsystem::RewindCharacters(float Time, const AActor* IgnoredActor)
+{
+	SCOPE_CYCLE_COUNTER(STAT_LagCompensationRewind);
+
+	if (bIsRewound)
+	{
+		RestoreCharacters();
+	}
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	Time = FMath::Clamp(Time, CurrentTime - MaxRewindTime, CurrentTime);
+
+	for (FLagCompensationRecord& Record : Records)
+	{
+		AGCBaseCharacter* Character = Record.Character.Get();
+		if (!IsValid(Character) || Character == IgnoredActor || Record.FrameCount == 0 || Time >= Record.FrameTimes[Record.NewestFrame])
+		{
+			continue;
+		}
+
+		// Newest frame that is not newer than the time, frames older than history use the oldest one.
+		int32 OlderFrame = Record.NewestFrame;
+		int32 NewerFrame = Record.NewestFrame;
+		for (int32 i = 0; i < Record.FrameCount; ++i)
+		{
+			OlderFrame = (Record.NewestFrame - i + HistoryFrames) % HistoryFrames;
+			if (Record.FrameTimes[OlderFrame] <= Time)
+			{
+				break;
+			}
+			NewerFrame = OlderFrame;
+		}
+
+		const float OlderTime = Record.FrameTimes[OlderFrame];
+		const float NewerTime = Record.FrameTimes[NewerFrame];
+		const float Alpha = NewerTime > OlderTime ? FMath::Clamp((Time - OlderTime) / (NewerTime - OlderTime), 0.0f, 1.0f) : 0.0f;
+
+		for (int32 BodyIndex = 0; BodyIndex < Record.BodyCount; ++BodyIndex)
+		{
+			FBodyInstance* Body = GetBody(Character, BodyIndex);
+			if (Body == nullptr)
+			{
+				continue;
+			}
+
+			FTransform RewoundTransform;
+			RewoundTransform.Blend(Record.BodyTransforms[OlderFrame * Record.BodyCount + BodyIndex], Record.BodyTransforms[NewerFrame * Record.BodyCount + BodyIndex], Alpha);
+
+			Record.RestoreTransforms[BodyIndex] = Body->GetUnrealWorldTransform();
+			Body->SetBodyTransform(RewoundTransform, ETeleportType::TeleportPhysics);
+		}
+
+		Record.bIsRewound = true;
+	}
+
+	bIsRewound = true;
+}
+
+void ULagCompensationSubsystem::RestoreCharacters()
+{
+	for (FLagCompensationRecord& Record : Records)
+	{
+		AGCBaseCharacter* Character = Record.Character.Get();
+		if (!Record.bIsRewound || !IsValid(Character))
+		{
+			Record.bIsRewound = false;
+			continue;
+		}
+
+		for (int32 BodyIndex = 0; BodyIndex < Record.BodyCount; ++BodyIndex)
+		{
+			FBodyInstance* Body = GetBody(Character, BodyIndex);
+			if (Body != nullptr)
+			{
+				Body->SetBodyTransform(Record.RestoreTransforms[BodyIndex], ETeleportType::TeleportPhysics);
+			}
+		}
+
+		Record.bIsRewound = false;
+	}
+
+	bIsRewound = false;
+}
+
+float ULagCompensationSubsystem::GetClientViewTime(const APawn* Pawn) const
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	const APlayerState* PlayerState = IsValid(Pawn) ? Pawn->GetPlayerState() : nullptr;
+	if (!IsValid(PlayerState) || Pawn->IsLocallyControlled())
+	{
+		return CurrentTime;
+	}
+
+	// Remote player sees other characters half of the round trip late.
+	return CurrentTime - PlayerState->GetPingInMilliseconds() * 0.0005f;
+}
+
+void ULagCompensationSubsystem::LagCompensationStats()
+{
+#if !UE_BUILD_SHIPPING
+	int64 TotalBytes = 0;
+	for (const FLagCompensationRecord& Record : Records)
+	{
+		const int64 RecordBytes = Record.BodyTransforms.GetAllocatedSize() + Record.FrameTimes.GetAllocatedSize() + Record.RestoreTransforms.GetAllocatedSize();
+		TotalBytes += RecordBytes;
+
+		UE_LOG(LogLagCompensationSubsystem, Display, TEXT("ULagCompensationSubsystem::LagCompensationStats(): %s, Bodies: %i, Frames: %i, Memory: %lld KB"),
+			*GetNameSafe(Record.Character.Get()), Record.BodyCount, Record.FrameCount, RecordBytes / 1024);
+	}
+
+	UE_LOG(LogLagCompensationSubsystem, Display, TEXT("ULagCompensationSubsystem::LagCompensationStats(): %i characters, Memory: %lld KB"), Records.Num(), TotalBytes / 1024);
+#endif
+}
+
+int32 ULagCompensationSubsystem::GetBodyCount(const AGCBaseCharacter* Character) const
+{
+	const USkeletalMeshComponent* Mesh = Character->GetMesh();
+	const int32 MeshBodyCount = IsValid(Mesh) ? Mesh->Bodies.Num() : 0;
+
+	return FMath::Clamp(1 + MeshBodyCount, 1, FMath::Max(MaxBodiesPerCharacter, 1));
+}
+
+FBodyInstance* ULagCompensationSubsystem::GetBody(AGCBaseCharacter* Character, int32 BodyIndex) const
+{
+	FBodyInstance* Body = nullptr;
+	if (BodyIndex == 0)
+	{
+		Body = Character->GetCapsuleComponent()->GetBodyInstance();
+	}
+	else
+	{
+		USkeletalMeshComponent* Mesh = Character->GetMesh();
+		if (IsValid(Mesh) && Mesh->Bodies.IsValidIndex(BodyIndex - 1))
+		{
+			Body = Mesh->Bodies[BodyIndex - 1];
+		}
+	}
+
+	return Body != nullptr && Body->IsValidBodyInstance() ? Body : nullptr;
+}
+
+void ULagCompensationSubsystem::RecordFrame(FLagCompensationRecord& Record, float Time)
+{
+	AGCBaseCharacter* Character = Record.Character.Get();
+
+	// Physics state of the mesh can be recreated with other bodies, old history doesn't match them.
+	const int32 BodyCount = GetBodyCount(Character);
+	if (BodyCount != Record.BodyCount)
+	{
+		ResetRecord(Record, BodyCount);
+	}
+
+	Record.NewestFrame = (Record.NewestFrame + 1) % HistoryFrames;
+	Record.FrameCount = FMath::Min(Record.FrameCount + 1, HistoryFrames);
+	Record.FrameTimes[Record.NewestFrame] = Time;
+
+	for (int32 BodyIndex = 0; BodyIndex < Record.BodyCount; ++BodyIndex)
+	{
+		const FBodyInstance* Body = GetBody(Character, BodyIndex);
+		Record.BodyTransforms[Record.NewestFrame * Record.BodyCount + BodyIndex] = Body != nullptr ? Body->GetUnrealWorldTransform() : FTransform::Identity;
+	}
+}
+
+void ULagCompensationSubsystem::ResetRecord(FLagCompensationRecord& Record, int32 BodyCount)
+{
+	HistoryFrames = FMath::Max(HistoryFrames, 1);
+
+	Record.BodyCount = BodyCount;
+	Record.BodyTransforms.SetNum(HistoryFrames * BodyCount);
+	Record.FrameTimes.SetNumZeroed(HistoryFrames);
+	Record.RestoreTransforms.SetNum(BodyCount);
+	Record.NewestFrame = INDEX_NONE;
+	Record.FrameCount = 0;
+	Record.bIsRewound = false;
+}
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "LagCompensationSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogLagCompensationSubsystem, Log, All);
+
+class AGCBaseCharacter;
+struct FBodyInstance;
+
+/** Collision history of one character. Buffers are allocated on registration and reused. */
+struct FLagCompensationRecord
+{
+	TWeakObjectPtr<AGCBaseCharacter> Character;
+	/** Capsule body and first hitbox bodies of the mesh */
+	int32 BodyCount = 0;
+	/** Ring buffer of frames, every frame has @BodyCount transforms */
+	TArray<FTransform> BodyTransforms;
+	TArray<float> FrameTimes;
+	int32 NewestFrame = INDEX_NONE;
+	int32 FrameCount = 0;
+	/** Body transforms before rewind */
+	TArray<FTransform> RestoreTransforms;
+	bool bIsRewound = false;
+};
+
+/**
+ * Server only. Records capsule and hitbox transforms of characters every tick,
+ * so hits of remote players can be checked against the world they saw.
+ */
+UCLASS(Config = Game)
+class GAMECODE_API ULagCompensationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	void RegisterCharacter(AGCBaseCharacter* Character);
+	void UnregisterCharacter(AGCBaseCharacter* Character);
+
+	/** Moves collision of all characters except @IgnoredActor to where it was at @Time. Must be followed by @RestoreCharacters. */
+	void RewindCharacters(float Time, const AActor* IgnoredActor);
+	void RestoreCharacters();
+
+	/** Server time the controller of @Pawn sees other characters at */
+	float GetClientViewTime(const APawn* Pawn) const;
+
+	/** Logs recorded characters, frames and history memory. */
+	UFUNCTION(Exec)
+	void LagCompensationStats();
+
+private:
+	int32 GetBodyCount(const AGCBaseCharacter* Character) const;
+	FBodyInstance* GetBody(AGCBaseCharacter* Character, int32 BodyIndex) const;
+	void RecordFrame(FLagCompensationRecord& Record, float Time);
+	void ResetRecord(FLagCompensationRecord& Record, int32 BodyCount);
+
+	TArray<FLagCompensationRecord> Records;
+	bool bIsRewound = false;
+
+	/** Number of recorded frames of every character */
+	UPROPERTY(Config)
+	int32 HistoryFrames = 64;
+
+	/** Capsule and mesh bodies recorded per character, limits memory of a character */
+	UPROPERTY(Config)
+	int32 MaxBodiesPerCharacter = 20;
+
+	/** Characters are not rewound further than this */
+	UPROPERTY(Config)
+	float MaxRewindTime = 0.5f;
+
+};
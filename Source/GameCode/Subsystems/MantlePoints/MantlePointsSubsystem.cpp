@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/MantlePoints/MantlePointsSubsystem.h"
+#include "Actors/Navigation/MantlePointsActor.h"
+#include "GameFramework/Character.h"
+
+void UMantlePointsSubsystem::Deinitialize()
+{
+	MantlePointsActors.Empty();
+
+	Super::Deinitialize();
+}
+
+void UMantlePointsSubsystem::RegisterMantlePoints(AMantlePointsActor* MantlePointsActor)
+{
+	MantlePointsActors.AddUnique(MantlePointsActor);
+}
+
+void UMantlePointsSubsystem::UnregisterMantlePoints(AMantlePointsActor* MantlePointsActor)
+{
+	MantlePointsActors.RemoveSwap(MantlePointsActor);
+}
+
+bool UMantlePointsSubsystem::FindMantlePoint(const ACharacter* Character, float MaxDistance, float MaxYawDelta, FMantlePoint& OutMantlePoint) const
+{
+	if (!IsValid(Character))
+	{
+		return false;
+	}
+
+	const FVector Location = Character->GetActorLocation();
+	const float Yaw = Character->GetActorRotation().Yaw;
+
+	const FMantlePoint* ClosestMantlePoint = nullptr;
+	float ClosestDistanceSquared = FMath::Square(MaxDistance);
+	for (const TWeakObjectPtr<AMantlePointsActor>& MantlePointsActor : MantlePointsActors)
+	{
+		if (!MantlePointsActor.IsValid() || !Character->IsA(MantlePointsActor->GetCharacterClass()))
+		{
+			continue;
+		}
+
+		float DistanceSquared;
+		const FMantlePoint* MantlePoint = MantlePointsActor->FindMantlePoint(Location, Yaw, MaxDistance, MaxYawDelta, DistanceSquared);
+		if (MantlePoint != nullptr && DistanceSquared <= ClosestDistanceSquared)
+		{
+			ClosestMantlePoint = MantlePoint;
+			ClosestDistanceSquared = DistanceSquared;
+		}
+	}
+
+	if (ClosestMantlePoint == nullptr)
+	{
+		return false;
+	}
+
+	OutMantlePoint = *ClosestMantlePoint;
+	return true;
+}
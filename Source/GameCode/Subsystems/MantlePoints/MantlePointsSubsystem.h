@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MantlePointsSubsystem.generated.h"
+
+class AMantlePointsActor;
+class ACharacter;
+struct FMantlePoint;
+
+/**
+ * Mantle points of all loaded levels. Levels register their baked mantle points actors when they begin play.
+ */
+UCLASS()
+class GAMECODE_API UMantlePointsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterMantlePoints(AMantlePointsActor* MantlePointsActor);
+	void UnregisterMantlePoints(AMantlePointsActor* MantlePointsActor);
+
+	/** Closest point baked for the class of @Character it can mantle from its current location and facing */
+	bool FindMantlePoint(const ACharacter* Character, float MaxDistance, float MaxYawDelta, FMantlePoint& OutMantlePoint) const;
+
+private:
+	TArray<TWeakObjectPtr<AMantlePointsActor>> MantlePointsActors;
+
+};
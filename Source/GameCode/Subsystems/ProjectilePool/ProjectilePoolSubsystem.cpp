@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ProjectilePool/ProjectilePoolSubsystem.h"
+#include "Actors/Projectiles/GCProjectile.h"
+
+DEFINE_LOG_CATEGORY(LogProjectilePoolSubsystem)
+
+AGCProjectile* UProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<AGCProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, AActor* Owner)
+{
+	if (!IsValid(ProjectileClass))
+	{
+		return nullptr;
+	}
+
+	FProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+
+	AGCProjectile* Projectile = nullptr;
+	while (Pool.FreeProjectiles.Num() > 0 && !IsValid(Projectile))
+	{
+		Projectile = Pool.FreeProjectiles.Pop(false);
+	}
+
+	if (IsValid(Projectile))
+	{
+		Projectile->SetActorLocationAndRotation(Location, Rotation);
+	}
+	else
+	{
+		if (Pool.ActiveProjectiles.Num() >= MaxPoolSize)
+		{
+			UE_LOG(LogProjectilePoolSubsystem, Warning, TEXT("UProjectilePoolSubsystem::AcquireProjectile(): %s, Pool of %s is full, MaxPoolSize: %i"), *GetNameSafe(this), *GetNameSafe(ProjectileClass), MaxPoolSize);
+			return nullptr;
+		}
+
+		Projectile = SpawnProjectile(ProjectileClass, Location, Rotation);
+		if (!IsValid(Projectile))
+		{
+			return nullptr;
+		}
+	}
+
+	Projectile->SetOwner(Owner);
+	SetProjectileIdle(Projectile, false);
+
+	Pool.ActiveProjectiles.Add(Projectile);
+	Pool.HighWaterMark = FMath::Max(Pool.HighWaterMark, Pool.ActiveProjectiles.Num());
+
+	return Projectile;
+}
+
+void UProjectilePoolSubsystem::ReleaseProjectile(AGCProjectile* Projectile)
+{
+	if (!IsValid(Projectile))
+	{
+		return;
+	}
+
+	FProjectilePool* Pool = Pools.Find(Projectile->GetClass());
+	if (Pool == nullptr || Pool->ActiveProjectiles.RemoveSwap(Projectile) == 0)
+	{
+		return;
+	}
+
+	Projectile->OnProjectileHit.Clear();
+	SetProjectileIdle(Projectile, true);
+
+	Pool->FreeProjectiles.Add(Projectile);
+}
+
+void UProjectilePoolSubsystem::PrewarmPool(TSubclassOf<AGCProjectile> ProjectileClass, int32 Count)
+{
+	if (!IsValid(ProjectileClass))
+	{
+		return;
+	}
+
+	FProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+	Count = FMath::Min(Count, MaxPoolSize);
+	while (Pool.FreeProjectiles.Num() + Pool.ActiveProjectiles.Num() < Count)
+	{
+		AGCProjectile* Projectile = SpawnProjectile(ProjectileClass, FVector::ZeroVector, FRotator::ZeroRotator);
+		if (!IsValid(Projectile))
+		{
+			return;
+		}
+
+		SetProjectileIdle(Projectile, true);
+		Pool.FreeProjectiles.Add(Projectile);
+	}
+}
+
+void UProjectilePoolSubsystem::ProjectilePoolStats()
+{
+#if !UE_BUILD_SHIPPING
+	for (const TPair<UClass*, FProjectilePool>& Pool : Pools)
+	{
+		const int32 ActiveCount = Pool.Value.ActiveProjectiles.Num();
+		UE_LOG(LogProjectilePoolSubsystem, Display, TEXT("UProjectilePoolSubsystem::ProjectilePoolStats(): %s, Size: %i, Active: %i, High-water mark: %i, Max: %i"),
+			*GetNameSafe(Pool.Key), ActiveCount + Pool.Value.FreeProjectiles.Num(), ActiveCount, Pool.Value.HighWaterMark, MaxPoolSize);
+	}
+#endif
+}
+
+AGCProjectile* UProjectilePoolSubsystem::SpawnProjectile(TSubclassOf<AGCProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AGCProjectile* Projectile = GetWorld()->SpawnActor<AGCProjectile>(ProjectileClass, Location, Rotation, SpawnParameters);
+	if (IsValid(Projectile))
+	{
+		Projectile->OnDestroyed.AddDynamic(this, &UProjectilePoolSubsystem::OnProjectileDestroyed);
+	}
+
+	return Projectile;
+}
+
+void UProjectilePoolSubsystem::SetProjectileIdle(AGCProjectile* Projectile, bool bIsIdle)
+{
+	Projectile->SetProjectileActive(!bIsIdle);
+	Projectile->SetActorHiddenInGame(bIsIdle);
+	Projectile->SetActorEnableCollision(!bIsIdle);
+	Projectile->SetActorTickEnabled(!bIsIdle);
+
+	// Idle projectiles are not replicated until they are used again.
+	Projectile->SetNetDormancy(bIsIdle ? DORM_DormantAll : DORM_Awake);
+}
+
+void UProjectilePoolSubsystem::OnProjectileDestroyed(AActor* DestroyedActor)
+{
+	FProjectilePool* Pool = Pools.Find(DestroyedActor->GetClass());
+	if (Pool == nullptr)
+	{
+		return;
+	}
+
+	AGCProjectile* Projectile = StaticCast<AGCProjectile*>(DestroyedActor);
+	Pool->ActiveProjectiles.RemoveSwap(Projectile);
+	Pool->FreeProjectiles.RemoveSwap(Projectile);
+}
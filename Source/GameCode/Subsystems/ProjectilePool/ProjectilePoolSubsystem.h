@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogProjectilePoolSubsystem, Log, All);
+
+class AGCProjectile;
+
+USTRUCT()
+struct FProjectilePool
+{
+	GENERATED_BODY()
+
+	/** Idle projectiles, hidden and dormant */
+	UPROPERTY()
+	TArray<AGCProjectile*> FreeProjectiles;
+
+	UPROPERTY()
+	TArray<AGCProjectile*> ActiveProjectiles;
+
+	/** Max number of active projectiles at the same time */
+	int32 HighWaterMark = 0;
+};
+
+/**
+ * Shared pools of projectiles by class. Pools grow on demand up to @MaxPoolSize.
+ */
+UCLASS(Config = Game)
+class GAMECODE_API UProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Takes idle projectile of @ProjectileClass or spawns a new one. Returns nullptr if the pool is full. */
+	AGCProjectile* AcquireProjectile(TSubclassOf<AGCProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, AActor* Owner);
+
+	/** Returns projectile to its pool. Projectiles that are not from a pool are ignored. */
+	void ReleaseProjectile(AGCProjectile* Projectile);
+
+	/** Spawns idle projectiles until the pool has @Count of them */
+	void PrewarmPool(TSubclassOf<AGCProjectile> ProjectileClass, int32 Count);
+
+	/** Logs size, active projectiles and high-water mark of every pool. */
+	UFUNCTION(Exec)
+	void ProjectilePoolStats();
+
+private:
+	AGCProjectile* SpawnProjectile(TSubclassOf<AGCProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation);
+	void SetProjectileIdle(AGCProjectile* Projectile, bool bIsIdle);
+
+	UFUNCTION()
+	void OnProjectileDestroyed(AActor* DestroyedActor);
+
+	UPROPERTY(Transient)
+	TMap<UClass*, FProjectilePool> Pools;
+
+	/** Max number of projectiles of one class */
+	UPROPERTY(Config)
+	int32 MaxPoolSize = 64;
+
+};
@@ -3,6 +3,105 @@
 
 #include "Subsystems/SaveSubsystem/SaveData.h"
 
+int32 FSaveDataNameTable::AddName(const FName& Name)
+{
+	const int32* NameIndex = NameIndices.Find(Name);
+	if (NameIndex != nullptr)
+	{
+		return *NameIndex;
+	}
+
+	const int32 NewNameIndex = Names.Add(Name);
+	NameIndices.Add(Name, NewNameIndex);
+	return NewNameIndex;
+}
+
+FName FSaveDataNameTable::GetName(int32 NameIndex) const
+{
+	return Names.IsValidIndex(NameIndex) ? Names[NameIndex] : NAME_None;
+}
+
+int32 FSaveDataNameTable::AddObject(const UObject* Object)
+{
+	if (Object == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	FString ObjectPath = Object->GetPathName();
+	const int32* ObjectIndex = ObjectPathIndices.Find(ObjectPath);
+	if (ObjectIndex != nullptr)
+	{
+		return *ObjectIndex;
+	}
+
+	const int32 NewObjectIndex = ObjectPaths.Add(ObjectPath);
+	ObjectPathIndices.Add(MoveTemp(ObjectPath), NewObjectIndex);
+	return NewObjectIndex;
+}
+
+UObject* FSaveDataNameTable::ResolveObject(int32 ObjectIndex) const
+{
+	if (!ObjectPaths.IsValidIndex(ObjectIndex))
+	{
+		return nullptr;
+	}
+
+	if (ResolvedObjects.Num() < ObjectPaths.Num())
+	{
+		ResolvedObjects.SetNum(ObjectPaths.Num());
+	}
+
+	UObject* Object = ResolvedObjects[ObjectIndex].Get();
+	if (Object == nullptr)
+	{
+		// Object can be unloaded with its level and loaded again, so search again if it is gone.
+		Object = FindObject<UObject>(nullptr, *ObjectPaths[ObjectIndex]);
+		ResolvedObjects[ObjectIndex] = Object;
+	}
+
+	return Object;
+}
+
+FArchive& operator << (FArchive& Archive, FSaveDataNameTable& NameTable)
+{
+	// Names are stored as strings, so table can be read by any archive.
+	TArray<FString> NameStrings;
+	if (Archive.IsSaving())
+	{
+		NameStrings.Reserve(NameTable.Names.Num());
+		for (const FName& Name : NameTable.Names)
+		{
+			NameStrings.Add(Name.ToString());
+		}
+	}
+
+	Archive << NameStrings;
+	Archive << NameTable.ObjectPaths;
+
+	if (Archive.IsLoading())
+	{
+		NameTable.Names.Empty(NameStrings.Num());
+		NameTable.NameIndices.Empty(NameStrings.Num());
+		for (const FString& NameString : NameStrings)
+		{
+			const FName Name(*NameString);
+			NameTable.NameIndices.Add(Name, NameTable.Names.Add(Name));
+		}
+
+		NameTable.ObjectPathIndices.Empty(NameTable.ObjectPaths.Num());
+		for (int32 i = 0; i < NameTable.ObjectPaths.Num(); ++i)
+		{
+			NameTable.ObjectPathIndices.Add(NameTable.ObjectPaths[i], i);
+		}
+
+		NameTable.ResolvedObjects.Empty();
+	}
+
+	return Archive;
+}
+
+//
 FBaseSaveData::FBaseSaveData()
 {
 
@@ -47,6 +146,12 @@ bool FObjectSaveData::Serialize(FArchive& Archive)
 	return true;
 }
 
+uint32 FObjectSaveData::GetDataHash() const
+{
+	const uint32 ClassHash = GetTypeHash(Class.Get());
+	return FCrc::MemCrc32(RawData.GetData(), RawData.Num(), ClassHash);
+}
+
 //
 FActorSaveData::FActorSaveData()
 	: Transform(FTransform::Identity)
@@ -64,9 +169,64 @@ bool FActorSaveData::Serialize(FArchive& Archive)
 	Super::Serialize(Archive);
 	Archive << Transform;
 	Archive << ComponentsSaveData;
+	Archive << bIsPartial;
+	Archive << RemovedComponents;
 	return true;
 }
 
+uint32 FActorSaveData::GetDataHash() const
+{
+	const FVector Location = Transform.GetLocation();
+	const FQuat Rotation = Transform.GetRotation();
+	const FVector Scale = Transform.GetScale3D();
+
+	uint32 Hash = Super::GetDataHash();
+	Hash = FCrc::MemCrc32(&Location, sizeof(Location), Hash);
+	Hash = FCrc::MemCrc32(&Rotation, sizeof(Rotation), Hash);
+	Hash = FCrc::MemCrc32(&Scale, sizeof(Scale), Hash);
+	return Hash;
+}
+
+void FActorSaveData::BuildComponentIndex()
+{
+	ComponentIndices.Empty(ComponentsSaveData.Num());
+	for (int32 i = 0; i < ComponentsSaveData.Num(); ++i)
+	{
+		ComponentIndices.Add(ComponentsSaveData[i].Name, i);
+	}
+}
+
+FObjectSaveData* FActorSaveData::FindComponentSaveData(const FName& ComponentName)
+{
+	const int32* ComponentIndex = ComponentIndices.Find(ComponentName);
+	return ComponentIndex != nullptr ? &ComponentsSaveData[*ComponentIndex] : nullptr;
+}
+
+const FObjectSaveData* FActorSaveData::FindComponentSaveData(const FName& ComponentName) const
+{
+	const int32* ComponentIndex = ComponentIndices.Find(ComponentName);
+	return ComponentIndex != nullptr ? &ComponentsSaveData[*ComponentIndex] : nullptr;
+}
+
+FObjectSaveData& FActorSaveData::AddComponentSaveData(const FObjectSaveData& ComponentSaveData)
+{
+	const int32 ComponentIndex = ComponentsSaveData.Add(ComponentSaveData);
+	ComponentIndices.Add(ComponentSaveData.Name, ComponentIndex);
+	return ComponentsSaveData[ComponentIndex];
+}
+
+void FActorSaveData::RemoveComponentsSaveData(const TArray<FName>& ComponentNames)
+{
+	if (ComponentNames.Num() == 0)
+	{
+		return;
+	}
+
+	const TSet<FName> RemovedComponentNames(ComponentNames);
+	ComponentsSaveData.RemoveAll([&](const FObjectSaveData& ComponentSaveData) { return RemovedComponentNames.Contains(ComponentSaveData.Name); });
+	BuildComponentIndex();
+}
+
 //
 FLevelSaveData::FLevelSaveData()
 {
@@ -81,9 +241,71 @@ bool FLevelSaveData::Serialize(FArchive& Archive)
 {
 	Super::Serialize(Archive);
 	Archive << ActorsSaveData;
+	Archive << RemovedActors;
+
+	if (Archive.IsLoading())
+	{
+		BuildActorIndex();
+	}
+
+	return true;
+}
+
+void FLevelSaveData::BuildActorIndex()
+{
+	ActorIndices.Empty(ActorsSaveData.Num());
+	for (int32 i = 0; i < ActorsSaveData.Num(); ++i)
+	{
+		ActorIndices.Add(ActorsSaveData[i].Name, i);
+		ActorsSaveData[i].BuildComponentIndex();
+	}
+}
+
+int32 FLevelSaveData::FindActorIndex(const FName& ActorName) const
+{
+	const int32* ActorIndex = ActorIndices.Find(ActorName);
+	return ActorIndex != nullptr ? *ActorIndex : INDEX_NONE;
+}
+
+FActorSaveData* FLevelSaveData::FindActorSaveData(const FName& ActorName)
+{
+	const int32 ActorIndex = FindActorIndex(ActorName);
+	return ActorIndex != INDEX_NONE ? &ActorsSaveData[ActorIndex] : nullptr;
+}
+
+FActorSaveData& FLevelSaveData::AddActorSaveData(const FActorSaveData& ActorSaveData)
+{
+	const int32 ActorIndex = ActorsSaveData.Add(ActorSaveData);
+	ActorIndices.Add(ActorSaveData.Name, ActorIndex);
+	return ActorsSaveData[ActorIndex];
+}
+
+bool FLevelSaveData::RenameActorSaveData(int32 ActorIndex, const FName& NewActorName)
+{
+	FActorSaveData& ActorSaveData = ActorsSaveData[ActorIndex];
+	if (ActorSaveData.Name == NewActorName)
+	{
+		return true;
+	}
+
+	// Replacing the index of another actor data would make it unreachable while both are still saved.
+	if (ActorIndices.Contains(NewActorName))
+	{
+		return false;
+	}
+
+	ActorIndices.Remove(ActorSaveData.Name);
+	ActorIndices.Add(NewActorName, ActorIndex);
+	ActorSaveData.Name = NewActorName;
 	return true;
 }
 
+void FLevelSaveData::EmptyActorsSaveData()
+{
+	ActorsSaveData.Empty();
+	ActorIndices.Empty();
+}
+
 //
 FGameSaveData::FGameSaveData()
 	: PersistentLevel(FName(TEXT("Persistent")))
@@ -93,13 +315,62 @@ FGameSaveData::FGameSaveData()
 
 bool FGameSaveData::Serialize(FArchive& Archive)
 {
-	Super::Serialize(Archive);
-	Archive << LevelName;
+	SerializeGameData(Archive);
 	Archive << PersistentLevel;
 	Archive << StreamingLevels;
+
+	if (Archive.IsLoading())
+	{
+		// Levels have already built their own indices.
+		StreamingLevelIndices.Empty(StreamingLevels.Num());
+		for (int32 i = 0; i < StreamingLevels.Num(); ++i)
+		{
+			StreamingLevelIndices.Add(StreamingLevels[i].Name, i);
+		}
+	}
+
+	return true;
+}
+
+void FGameSaveData::SerializeGameData(FArchive& Archive)
+{
+	Super::Serialize(Archive);
+	Archive << LevelName;
 	Archive << GameInstance;
 	Archive << StartTransform;
+	Archive << PreviousSaveId;
+	Archive << DeltaChainLength;
+	Archive << NameTable;
+}
 
-	return true;
+void FGameSaveData::BuildIndex()
+{
+	PersistentLevel.BuildActorIndex();
+
+	StreamingLevelIndices.Empty(StreamingLevels.Num());
+	for (int32 i = 0; i < StreamingLevels.Num(); ++i)
+	{
+		StreamingLevelIndices.Add(StreamingLevels[i].Name, i);
+		StreamingLevels[i].BuildActorIndex();
+	}
+}
+
+FLevelSaveData* FGameSaveData::FindStreamingLevelSaveData(const FName& LevelName)
+{
+	const int32* LevelIndex = StreamingLevelIndices.Find(LevelName);
+	return LevelIndex != nullptr ? &StreamingLevels[*LevelIndex] : nullptr;
+}
+
+FLevelSaveData& FGameSaveData::FindOrAddStreamingLevelSaveData(const FName& LevelName)
+{
+	const int32* LevelIndex = StreamingLevelIndices.Find(LevelName);
+	if (LevelIndex != nullptr)
+	{
+		return StreamingLevels[*LevelIndex];
+	}
+
+	const int32 NewLevelIndex = StreamingLevels.Emplace(LevelName);
+	StreamingLevelIndices.Add(LevelName, NewLevelIndex);
+	return StreamingLevels[NewLevelIndex];
 }
 
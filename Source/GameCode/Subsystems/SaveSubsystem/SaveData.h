@@ -4,8 +4,35 @@
 
 #include "CoreMinimal.h"
 #include "UObject/StrongObjectPtr.h"
+#include "UObject/WeakObjectPtr.h"
 #include "SaveData.generated.h"
 
+/**
+ * Names and object paths referenced by raw data of saved objects. Raw data stores indices to these tables.
+ * Tables are only appended to, so indices stay valid for all saves of a delta save chain.
+ */
+struct FSaveDataNameTable
+{
+public:
+	int32 AddName(const FName& Name);
+	FName GetName(int32 NameIndex) const;
+
+	int32 AddObject(const UObject* Object);
+	/** Object is searched by path only once, then the found object is reused. */
+	UObject* ResolveObject(int32 ObjectIndex) const;
+
+	friend FArchive& operator << (FArchive& Archive, FSaveDataNameTable& NameTable);
+
+private:
+	TArray<FName> Names;
+	TMap<FName, int32> NameIndices;
+
+	TArray<FString> ObjectPaths;
+	TMap<FString, int32> ObjectPathIndices;
+	/** Objects found by @ObjectPaths. Not saved. */
+	mutable TArray<FWeakObjectPtr> ResolvedObjects;
+};
+
 USTRUCT()
 struct FBaseSaveData
 {
@@ -43,6 +70,9 @@ public:
 
 	virtual bool Serialize(FArchive& Archive) override;
 
+	/** Content hash of the saved data. Valid only for current session. */
+	virtual uint32 GetDataHash() const;
+
 	TStrongObjectPtr<UClass> Class;
 	TArray<uint8> RawData;
 };
@@ -60,8 +90,29 @@ struct FActorSaveData : public FObjectSaveData
 
 	virtual bool Serialize(FArchive& Archive) override;
 
+	/** Hash of actor data only. Components are hashed separately. */
+	virtual uint32 GetDataHash() const override;
+
+	/** Rebuilds component name index. Must be called after @ComponentsSaveData is changed directly. */
+	void BuildComponentIndex();
+
+	FObjectSaveData* FindComponentSaveData(const FName& ComponentName);
+	const FObjectSaveData* FindComponentSaveData(const FName& ComponentName) const;
+	FObjectSaveData& AddComponentSaveData(const FObjectSaveData& ComponentSaveData);
+	void RemoveComponentsSaveData(const TArray<FName>& ComponentNames);
+
 	TArray<FObjectSaveData> ComponentsSaveData;
 	FTransform Transform;
+
+	/** Used by delta saves. Actor data is not changed, only changed components are stored. */
+	bool bIsPartial = false;
+
+	/** Used by delta saves. Components that were saved in the previous save but not in this one. */
+	TArray<FName> RemovedComponents;
+
+private:
+	/** Component name to index in @ComponentsSaveData. Not saved. */
+	TMap<FName, int32> ComponentIndices;
 };
 
 /**
@@ -78,7 +129,24 @@ public:
 
 	virtual bool Serialize(FArchive& Archive) override;
 
+	/** Rebuilds actor and component name indices. Called on load, must be called after @ActorsSaveData is changed directly. */
+	void BuildActorIndex();
+
+	int32 FindActorIndex(const FName& ActorName) const;
+	FActorSaveData* FindActorSaveData(const FName& ActorName);
+	FActorSaveData& AddActorSaveData(const FActorSaveData& ActorSaveData);
+	/** Returns false and keeps the old name if another actor data already uses @NewActorName */
+	bool RenameActorSaveData(int32 ActorIndex, const FName& NewActorName);
+	void EmptyActorsSaveData();
+
 	TArray<FActorSaveData> ActorsSaveData;
+
+	/** Used by delta saves. Actors removed since previous save. */
+	TArray<FName> RemovedActors;
+
+private:
+	/** Actor name to index in @ActorsSaveData. Not saved. */
+	TMap<FName, int32> ActorIndices;
 };
 
 /**
@@ -94,10 +162,34 @@ public:
 
 	virtual bool Serialize(FArchive& Archive) override;
 
+	/** Serializes everything except levels. Levels are stored in separate sections of save file. */
+	void SerializeGameData(FArchive& Archive);
+
 	FName LevelName;
 	FLevelSaveData PersistentLevel;
 	TArray<FLevelSaveData> StreamingLevels;
 	FObjectSaveData GameInstance;
 	FTransform StartTransform;
 
+	/** Shared by raw data of all objects in this save */
+	FSaveDataNameTable NameTable;
+
+	/** Save this delta save is based on. 0 means this is a full save. */
+	int32 PreviousSaveId = 0;
+
+	/** Number of delta saves from the last full save. */
+	int32 DeltaChainLength = 0;
+
+	bool IsDeltaSave() const { return PreviousSaveId != 0; }
+
+	/** Rebuilds level, actor and component name indices. Called on load. */
+	void BuildIndex();
+
+	FLevelSaveData* FindStreamingLevelSaveData(const FName& LevelName);
+	FLevelSaveData& FindOrAddStreamingLevelSaveData(const FName& LevelName);
+
+private:
+	/** Streaming level name to index in @StreamingLevels. Not saved. */
+	TMap<FName, int32> StreamingLevelIndices;
+
 };
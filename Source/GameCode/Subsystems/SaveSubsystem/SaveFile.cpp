@@ -0,0 +1,377 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/SaveSubsystem/SaveFile.h"
+#include "SaveSubsystemTypes.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Compression.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+bool FSaveFileCompression::CompressBlocks(FName CompressionFormat, int32 BlockSize, const TArray<uint8>& UncompressedBytes, TArray<uint8>& OutCompressedBytes, TArray<int32>& OutBlockSizes)
+{
+	check(BlockSize > 0);
+
+	const int32 BlockCount = FMath::DivideAndRoundUp(UncompressedBytes.Num(), BlockSize);
+	TArray<TArray<uint8>> CompressedBlocks;
+	CompressedBlocks.SetNum(BlockCount);
+	OutBlockSizes.SetNumZeroed(BlockCount);
+
+	ParallelFor(BlockCount, [&](int32 BlockIndex)
+	{
+		const int32 BlockOffset = BlockIndex * BlockSize;
+		const int32 UncompressedBlockSize = FMath::Min(BlockSize, UncompressedBytes.Num() - BlockOffset);
+
+		int32 CompressedBlockSize = FCompression::CompressMemoryBound(CompressionFormat, UncompressedBlockSize);
+		TArray<uint8>& CompressedBlock = CompressedBlocks[BlockIndex];
+		CompressedBlock.SetNumUninitialized(CompressedBlockSize);
+		if (FCompression::CompressMemory(CompressionFormat, CompressedBlock.GetData(), CompressedBlockSize, UncompressedBytes.GetData() + BlockOffset, UncompressedBlockSize))
+		{
+			OutBlockSizes[BlockIndex] = CompressedBlockSize;
+		}
+		else
+		{
+			OutBlockSizes[BlockIndex] = INDEX_NONE;
+		}
+	});
+
+	int32 CompressedSize = 0;
+	for (const int32 CompressedBlockSize : OutBlockSizes)
+	{
+		if (CompressedBlockSize == INDEX_NONE)
+		{
+			return false;
+		}
+
+		CompressedSize += CompressedBlockSize;
+	}
+
+	OutCompressedBytes.Reset(CompressedSize);
+	for (int32 BlockIndex = 0; BlockIndex < BlockCount; ++BlockIndex)
+	{
+		OutCompressedBytes.Append(CompressedBlocks[BlockIndex].GetData(), OutBlockSizes[BlockIndex]);
+	}
+
+	return true;
+}
+
+bool FSaveFileCompression::UncompressBlocks(FName CompressionFormat, int32 BlockSize, const uint8* CompressedData, int32 CompressedSize, const TArray<int32>& BlockSizes, TArray<uint8>& OutUncompressedBytes)
+{
+	if (BlockSize <= 0 || BlockSizes.Num() != FMath::DivideAndRoundUp(OutUncompressedBytes.Num(), BlockSize))
+	{
+		return false;
+	}
+
+	// Block offsets are needed before blocks can be decompressed independently.
+	TArray<int64> BlockOffsets;
+	BlockOffsets.SetNumUninitialized(BlockSizes.Num());
+	int64 BlockOffset = 0;
+	for (int32 BlockIndex = 0; BlockIndex < BlockSizes.Num(); ++BlockIndex)
+	{
+		if (BlockSizes[BlockIndex] < 0)
+		{
+			return false;
+		}
+
+		BlockOffsets[BlockIndex] = BlockOffset;
+		BlockOffset += BlockSizes[BlockIndex];
+	}
+
+	if (BlockOffset != CompressedSize)
+	{
+		return false;
+	}
+
+	TArray<bool> BlockResults;
+	BlockResults.SetNumZeroed(BlockSizes.Num());
+
+	ParallelFor(BlockSizes.Num(), [&](int32 BlockIndex)
+	{
+		const int32 UncompressedBlockOffset = BlockIndex * BlockSize;
+		const int32 UncompressedBlockSize = FMath::Min(BlockSize, OutUncompressedBytes.Num() - UncompressedBlockOffset);
+		BlockResults[BlockIndex] = FCompression::UncompressMemory(CompressionFormat, OutUncompressedBytes.GetData() + UncompressedBlockOffset, UncompressedBlockSize, CompressedData + BlockOffsets[BlockIndex], BlockSizes[BlockIndex]);
+	});
+
+	return !BlockResults.Contains(false);
+}
+
+FName FSaveFileCompression::GetValidCompressionFormat(FName CompressionFormat)
+{
+	if (CompressionFormat.IsNone() || FCompression::IsFormatValid(CompressionFormat))
+	{
+		return CompressionFormat;
+	}
+
+	UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileCompression::GetValidCompressionFormat(): Compression format %s is not available, saves are not compressed"), *CompressionFormat.ToString());
+	return NAME_None;
+}
+
+//
+bool FSaveFileWriter::Write(FGameSaveData& SaveData, const FString& FilePath, FName CompressionFormat, int32 CompressionBlockSize)
+{
+	// Can be called from a worker thread.
+	FArchive* FileWriter = IFileManager::Get().CreateFileWriter(*FilePath);
+	if (FileWriter == nullptr)
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileWriter::Write(): Failed to create file %s"), *FilePath);
+		return false;
+	}
+
+	// Header is written again when table of contents offset is known.
+	FSaveFileHeader Header;
+	*FileWriter << Header;
+
+	FSaveFileTableOfContents TableOfContents;
+	TableOfContents.CompressionFormat = CompressionFormat;
+	TableOfContents.CompressionBlockSize = CompressionFormat.IsNone() ? 0 : CompressionBlockSize;
+	TableOfContents.GameSection.Name = SaveData.Name;
+	TableOfContents.PersistentLevelSection.Name = SaveData.PersistentLevel.Name;
+
+	bool bIsSuccess = true;
+	TArray<uint8> SectionBytes;
+	{
+		FMemoryWriter MemoryWriter(SectionBytes, true);
+		FObjectAndNameAsStringProxyArchive WriterArchive(MemoryWriter, false);
+		SaveData.SerializeGameData(WriterArchive);
+		bIsSuccess &= WriteSection(*FileWriter, SectionBytes, TableOfContents, TableOfContents.GameSection);
+	}
+
+	{
+		SectionBytes.Reset();
+		FMemoryWriter MemoryWriter(SectionBytes, true);
+		FObjectAndNameAsStringProxyArchive WriterArchive(MemoryWriter, false);
+		SaveData.PersistentLevel.Serialize(WriterArchive);
+		bIsSuccess &= WriteSection(*FileWriter, SectionBytes, TableOfContents, TableOfContents.PersistentLevelSection);
+	}
+
+	TableOfContents.StreamingLevelSections.Reserve(SaveData.StreamingLevels.Num());
+	for (FLevelSaveData& LevelSaveData : SaveData.StreamingLevels)
+	{
+		SectionBytes.Reset();
+		FMemoryWriter MemoryWriter(SectionBytes, true);
+		FObjectAndNameAsStringProxyArchive WriterArchive(MemoryWriter, false);
+		LevelSaveData.Serialize(WriterArchive);
+
+		FSaveFileSection& LevelSection = TableOfContents.StreamingLevelSections.AddDefaulted_GetRef();
+		LevelSection.Name = LevelSaveData.Name;
+		bIsSuccess &= WriteSection(*FileWriter, SectionBytes, TableOfContents, LevelSection);
+	}
+
+	Header.TableOfContentsOffset = FileWriter->Tell();
+	FNameAsStringProxyArchive TableOfContentsArchive(*FileWriter);
+	TableOfContentsArchive << TableOfContents;
+
+	FileWriter->Seek(0);
+	*FileWriter << Header;
+
+	bIsSuccess &= !FileWriter->IsError();
+	bIsSuccess &= FileWriter->Close();
+	delete FileWriter;
+
+	UE_CLOG(!bIsSuccess, LogSaveSubsystem, Warning, TEXT("FSaveFileWriter::Write(): Failed to write file %s"), *FilePath);
+	return bIsSuccess;
+}
+
+bool FSaveFileWriter::WriteSection(FArchive& FileWriter, const TArray<uint8>& SectionBytes, const FSaveFileTableOfContents& TableOfContents, FSaveFileSection& OutSection)
+{
+	OutSection.Offset = FileWriter.Tell();
+	OutSection.UncompressedSize = SectionBytes.Num();
+
+	if (TableOfContents.CompressionFormat.IsNone())
+	{
+		OutSection.Size = SectionBytes.Num();
+		FileWriter.Serialize(const_cast<uint8*>(SectionBytes.GetData()), SectionBytes.Num());
+		return !FileWriter.IsError();
+	}
+
+	TArray<uint8> CompressedBytes;
+	if (!FSaveFileCompression::CompressBlocks(TableOfContents.CompressionFormat, TableOfContents.CompressionBlockSize, SectionBytes, CompressedBytes, OutSection.BlockSizes))
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileWriter::WriteSection(): Failed to compress section %s with %s"), *OutSection.Name.ToString(), *TableOfContents.CompressionFormat.ToString());
+		return false;
+	}
+
+	OutSection.Size = CompressedBytes.Num();
+	FileWriter.Serialize(CompressedBytes.GetData(), CompressedBytes.Num());
+	return !FileWriter.IsError();
+}
+
+//
+FSaveFileReader::~FSaveFileReader()
+{
+}
+
+bool FSaveFileReader::Open(const FString& InFilePath)
+{
+	FilePath = InFilePath;
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader.IsValid())
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileReader::Open(): Failed to open file %s"), *FilePath);
+		return false;
+	}
+
+	FSaveFileHeader Header;
+	*Reader << Header;
+	if (Reader->IsError() || Header.Magic != SaveFileMagic || Header.Version != SaveFileVersion)
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileReader::Open(): File %s is not a save file or has unsupported version"), *FilePath);
+		return false;
+	}
+
+	if (Header.TableOfContentsOffset < Reader->Tell() || Header.TableOfContentsOffset >= Reader->TotalSize())
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileReader::Open(): File %s has invalid table of contents offset"), *FilePath);
+		return false;
+	}
+
+	Reader->Seek(Header.TableOfContentsOffset);
+	FNameAsStringProxyArchive TableOfContentsArchive(*Reader);
+	TableOfContentsArchive << TableOfContents;
+	if (Reader->IsError())
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileReader::Open(): Failed to read table of contents of %s"), *FilePath);
+		return false;
+	}
+
+	// Sections are read straight from the mapping. Otherwise fall back to regular reads.
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (!MappedFile.IsValid())
+	{
+		FileReader = MoveTemp(Reader);
+	}
+
+	return true;
+}
+
+bool FSaveFileReader::ReadGameData(FGameSaveData& OutSaveData)
+{
+	TArray<uint8> SectionBytes;
+	if (!ReadSection(TableOfContents.GameSection, SectionBytes))
+	{
+		return false;
+	}
+
+	OutSaveData = FGameSaveData();
+	{
+		FMemoryReader MemoryReader(SectionBytes, true);
+		FObjectAndNameAsStringProxyArchive ReaderArchive(MemoryReader, true);
+		OutSaveData.SerializeGameData(ReaderArchive);
+		if (ReaderArchive.IsError())
+		{
+			return false;
+		}
+	}
+
+	if (!ReadSection(TableOfContents.PersistentLevelSection, SectionBytes))
+	{
+		return false;
+	}
+
+	FMemoryReader MemoryReader(SectionBytes, true);
+	FObjectAndNameAsStringProxyArchive ReaderArchive(MemoryReader, true);
+	OutSaveData.PersistentLevel.Serialize(ReaderArchive);
+	return !ReaderArchive.IsError();
+}
+
+bool FSaveFileReader::ReadStreamingLevel(const FName& LevelName, FLevelSaveData& OutLevelSaveData)
+{
+	const FSaveFileSection* LevelSection = TableOfContents.StreamingLevelSections.FindByPredicate([&](const FSaveFileSection& Section) { return Section.Name == LevelName; });
+	if (LevelSection == nullptr)
+	{
+		return false;
+	}
+
+	TArray<uint8> SectionBytes;
+	if (!ReadSection(*LevelSection, SectionBytes))
+	{
+		return false;
+	}
+
+	FMemoryReader MemoryReader(SectionBytes, true);
+	FObjectAndNameAsStringProxyArchive ReaderArchive(MemoryReader, true);
+	OutLevelSaveData = FLevelSaveData();
+	OutLevelSaveData.Serialize(ReaderArchive);
+	return !ReaderArchive.IsError();
+}
+
+bool FSaveFileReader::HasStreamingLevel(const FName& LevelName) const
+{
+	return TableOfContents.StreamingLevelSections.ContainsByPredicate([&](const FSaveFileSection& Section) { return Section.Name == LevelName; });
+}
+
+void FSaveFileReader::GetStreamingLevelNames(TArray<FName>& OutLevelNames) const
+{
+	OutLevelNames.Reserve(OutLevelNames.Num() + TableOfContents.StreamingLevelSections.Num());
+	for (const FSaveFileSection& LevelSection : TableOfContents.StreamingLevelSections)
+	{
+		OutLevelNames.Add(LevelSection.Name);
+	}
+}
+
+bool FSaveFileReader::ReadSection(const FSaveFileSection& Section, TArray<uint8>& OutSectionBytes)
+{
+	const int64 FileSize = MappedFile.IsValid() ? MappedFile->GetFileSize() : FileReader->TotalSize();
+	if (Section.Offset < 0 || Section.Size < 0 || Section.UncompressedSize < 0 || Section.Offset + Section.Size > FileSize)
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileReader::ReadSection(): Section %s is out of file %s"), *Section.Name.ToString(), *FilePath);
+		return false;
+	}
+
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> FileBytes;
+	const uint8* SectionData = nullptr;
+
+	if (MappedFile.IsValid())
+	{
+		MappedRegion.Reset(MappedFile->MapRegion(Section.Offset, Section.Size));
+		if (!MappedRegion.IsValid())
+		{
+			UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileReader::ReadSection(): Failed to map section %s of %s"), *Section.Name.ToString(), *FilePath);
+			return false;
+		}
+
+		SectionData = MappedRegion->GetMappedPtr();
+	}
+	else
+	{
+		FileBytes.SetNumUninitialized(Section.Size);
+		FileReader->Seek(Section.Offset);
+		FileReader->Serialize(FileBytes.GetData(), Section.Size);
+		if (FileReader->IsError())
+		{
+			UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileReader::ReadSection(): Failed to read section %s of %s"), *Section.Name.ToString(), *FilePath);
+			return false;
+		}
+
+		if (TableOfContents.CompressionFormat.IsNone())
+		{
+			OutSectionBytes = MoveTemp(FileBytes);
+			return true;
+		}
+
+		SectionData = FileBytes.GetData();
+	}
+
+	if (TableOfContents.CompressionFormat.IsNone())
+	{
+		OutSectionBytes.SetNumUninitialized(Section.Size);
+		FMemory::Memcpy(OutSectionBytes.GetData(), SectionData, Section.Size);
+		return true;
+	}
+
+	OutSectionBytes.SetNumUninitialized(Section.UncompressedSize);
+	if (!FSaveFileCompression::UncompressBlocks(TableOfContents.CompressionFormat, TableOfContents.CompressionBlockSize, SectionData, Section.Size, Section.BlockSizes, OutSectionBytes))
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("FSaveFileReader::ReadSection(): Failed to decompress section %s of %s"), *Section.Name.ToString(), *FilePath);
+		return false;
+	}
+
+	return true;
+}
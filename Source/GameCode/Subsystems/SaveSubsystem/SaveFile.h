@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveData.h"
+
+class IMappedFileHandle;
+
+const uint32 SaveFileMagic = 0x56534347;
+const int32 SaveFileVersion = 4;
+
+/**
+ * Fixed size header at the beginning of save file.
+ */
+struct FSaveFileHeader
+{
+	uint32 Magic = SaveFileMagic;
+	int32 Version = SaveFileVersion;
+	int64 TableOfContentsOffset = 0;
+
+	friend FArchive& operator << (FArchive& Archive, FSaveFileHeader& Header)
+	{
+		Archive << Header.Magic;
+		Archive << Header.Version;
+		Archive << Header.TableOfContentsOffset;
+		return Archive;
+	}
+};
+
+/**
+ * Independently compressed part of save file.
+ */
+struct FSaveFileSection
+{
+	FName Name;
+	int64 Offset = 0;
+	int32 Size = 0;
+	int32 UncompressedSize = 0;
+	/** Compressed size of every block. Empty if section is not compressed. */
+	TArray<int32> BlockSizes;
+
+	friend FArchive& operator << (FArchive& Archive, FSaveFileSection& Section)
+	{
+		Archive << Section.Name;
+		Archive << Section.Offset;
+		Archive << Section.Size;
+		Archive << Section.UncompressedSize;
+		Archive << Section.BlockSizes;
+		return Archive;
+	}
+};
+
+/**
+ * Save file layout: header, sections, table of contents.
+ * Game data and every level are separate sections, so levels can be read on demand.
+ */
+struct FSaveFileTableOfContents
+{
+	/** NAME_None if sections are not compressed */
+	FName CompressionFormat;
+	/** Uncompressed size of section block. Last block of section can be smaller. */
+	int32 CompressionBlockSize = 0;
+	FSaveFileSection GameSection;
+	FSaveFileSection PersistentLevelSection;
+	TArray<FSaveFileSection> StreamingLevelSections;
+
+	friend FArchive& operator << (FArchive& Archive, FSaveFileTableOfContents& TableOfContents)
+	{
+		Archive << TableOfContents.CompressionFormat;
+		Archive << TableOfContents.CompressionBlockSize;
+		Archive << TableOfContents.GameSection;
+		Archive << TableOfContents.PersistentLevelSection;
+		Archive << TableOfContents.StreamingLevelSections;
+		return Archive;
+	}
+};
+
+/**
+ * Section payload is split into fixed size blocks that are compressed and decompressed in parallel.
+ * Any format registered in FCompression can be used.
+ */
+class FSaveFileCompression
+{
+public:
+	static bool CompressBlocks(FName CompressionFormat, int32 BlockSize, const TArray<uint8>& UncompressedBytes, TArray<uint8>& OutCompressedBytes, TArray<int32>& OutBlockSizes);
+
+	/** @OutUncompressedBytes must already have uncompressed size of the data. */
+	static bool UncompressBlocks(FName CompressionFormat, int32 BlockSize, const uint8* CompressedData, int32 CompressedSize, const TArray<int32>& BlockSizes, TArray<uint8>& OutUncompressedBytes);
+
+	/** Returns NAME_None if format is not available on this platform. */
+	static FName GetValidCompressionFormat(FName CompressionFormat);
+};
+
+/**
+ * Writes save data to file. Can be used from any thread.
+ */
+class FSaveFileWriter
+{
+public:
+	static bool Write(FGameSaveData& SaveData, const FString& FilePath, FName CompressionFormat, int32 CompressionBlockSize);
+
+private:
+	static bool WriteSection(FArchive& FileWriter, const TArray<uint8>& SectionBytes, const FSaveFileTableOfContents& TableOfContents, FSaveFileSection& OutSection);
+};
+
+/**
+ * Reads sections of save file on demand. File is memory mapped when platform supports it.
+ */
+class FSaveFileReader
+{
+public:
+	~FSaveFileReader();
+
+	bool Open(const FString& InFilePath);
+
+	/** Reads game data and persistent level. Streaming levels are not read. */
+	bool ReadGameData(FGameSaveData& OutSaveData);
+	bool ReadStreamingLevel(const FName& LevelName, FLevelSaveData& OutLevelSaveData);
+
+	bool HasStreamingLevel(const FName& LevelName) const;
+	void GetStreamingLevelNames(TArray<FName>& OutLevelNames) const;
+
+private:
+	bool ReadSection(const FSaveFileSection& Section, TArray<uint8>& OutSectionBytes);
+
+	FString FilePath;
+	FSaveFileTableOfContents TableOfContents;
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	/** Used when file can't be memory mapped */
+	TUniquePtr<FArchive> FileReader;
+};
@@ -7,10 +7,9 @@
 #include "SaveSubsystemInterface.h"
 #include "SaveSubsystemUtils.h"
 #include "GameFramework/Character.h"
-#include "Serialization/ArchiveSaveCompressedProxy.h"
-#include "Serialization/ArchiveLoadCompressedProxy.h"
 #include "Engine/Level.h"
 #include "Engine/LevelStreaming.h"
+#include "Async/Async.h"
 
 
 const FGameSaveData& USaveSubsystem::GetGameSaveData() const
@@ -49,14 +48,60 @@ void USaveSubsystem::LoadGame(int32 SaveId)
 		UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::LoadGame(): Failed!"));
 		return;
 	}
-	
+
+	if (!LoadSaveFromFile(SaveId))
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::LoadGame(): Failed to load save %i!"), SaveId);
+		return;
+	}
+
 	RemoveStreamingLevelObservers();
 
-	LoadSaveFromFile(SaveId);
 	UGameplayStatics::OpenLevel(this, GameSaveData.LevelName);
 
 }
 
+void USaveSubsystem::CompactSave(int32 SaveId)
+{
+	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::CompactSave(): %s, SaveId %i"), *GetNameSafe(this), SaveId);
+	if (!SaveIds.Contains(SaveId))
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::CompactSave(): Failed! No save %i."), SaveId);
+		return;
+	}
+
+	// Save file can't be replaced while it is open.
+	DecodePendingStreamingLevels();
+
+	FGameSaveData SaveData;
+	if (!ReadSaveChainFromFile(SaveId, SaveData))
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::CompactSave(): Failed to read save %i!"), SaveId);
+		return;
+	}
+
+	if (!SaveData.IsDeltaSave())
+	{
+		return;
+	}
+
+	SaveData.PreviousSaveId = 0;
+	SaveData.DeltaChainLength = 0;
+
+	// Later delta saves still reference this save. It keeps the same content, so they stay valid.
+	if (!WriteSaveDataToFile(SaveData, GetSaveFilePath(SaveId), SaveCompressionFormat, SaveCompressionBlockSize))
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::CompactSave(): Failed to write save %i!"), SaveId);
+		return;
+	}
+
+	if (LastSaveId == SaveId)
+	{
+		LastSaveDeltaChainLength = 0;
+	}
+
+}
+
 void USaveSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -66,6 +111,9 @@ void USaveSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	SaveDirectoryName = FString::Printf(TEXT("%sSaveGames/"), *FPaths::ProjectSavedDir());
 
+	SaveCompressionFormat = FSaveFileCompression::GetValidCompressionFormat(SaveCompressionFormat);
+	SaveCompressionBlockSize = FMath::Max(SaveCompressionBlockSize, 4 * 1024);
+
 	FSaveDirectoryVisitor DirectoryVisitor(SaveIds);
 	FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*SaveDirectoryName, DirectoryVisitor);
 	SaveIds.Sort();
@@ -84,6 +132,10 @@ void USaveSubsystem::Deinitialize()
 
 	RemoveStreamingLevelObservers();
 
+	WaitForPendingSaves();
+
+	ReleaseSaveFiles();
+
 	Super::Deinitialize();
 }
 
@@ -105,6 +157,23 @@ UWorld* USaveSubsystem::GetWorld() const
 
 }
 
+bool USaveSubsystem::IsSaveInProgress() const
+{
+	return PendingSaves.Num() > 0;
+}
+
+void USaveSubsystem::SetSaveCompressionFormat(FName CompressionFormat)
+{
+	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::SetSaveCompressionFormat(): %s, Format %s"), *GetNameSafe(this), *CompressionFormat.ToString());
+
+	SaveCompressionFormat = FSaveFileCompression::GetValidCompressionFormat(CompressionFormat);
+}
+
+FName USaveSubsystem::GetSaveCompressionFormat() const
+{
+	return SaveCompressionFormat;
+}
+
 void USaveSubsystem::SerializeLevel(const ULevel* Level, const ULevelStreaming* StreamingLevel /*= nullptr*/)
 {
 	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::SerializeLevel(): %s, Level: %s, StreamingLevel: %s"), *GetNameSafe(this), *GetNameSafe(Level), *GetNameSafe(StreamingLevel));
@@ -112,8 +181,11 @@ void USaveSubsystem::SerializeLevel(const ULevel* Level, const ULevelStreaming*
 	FLevelSaveData* LevelSaveData = nullptr;
 	if (IsValid(StreamingLevel))
 	{
-		TArray<FLevelSaveData>& StreamingLevles = GameSaveData.StreamingLevels;
-		LevelSaveData = &StreamingLevles[StreamingLevles.Emplace(StreamingLevel->GetWorldAssetPackageFName())];
+		const FName LevelName = StreamingLevel->GetWorldAssetPackageFName();
+
+		// Decoded data is overwritten, but its hashes keep the next delta save small.
+		DecodeStreamingLevel(LevelName);
+		LevelSaveData = &GameSaveData.FindOrAddStreamingLevelSaveData(LevelName);
 
 	}
 	else
@@ -122,8 +194,7 @@ void USaveSubsystem::SerializeLevel(const ULevel* Level, const ULevelStreaming*
 
 	}
 
-	TArray<FActorSaveData>& ActorsSaveData = LevelSaveData->ActorsSaveData;
-	ActorsSaveData.Empty();
+	LevelSaveData->EmptyActorsSaveData();
 
 	for (AActor* Actor : Level->Actors)
 	{
@@ -132,25 +203,23 @@ void USaveSubsystem::SerializeLevel(const ULevel* Level, const ULevelStreaming*
 			continue;
 		}
 
-		FActorSaveData& ActorSaveData = ActorsSaveData[ActorsSaveData.AddUnique(FActorSaveData(Actor))];
+		// Actor names are unique in a level.
+		FActorSaveData& ActorSaveData = LevelSaveData->AddActorSaveData(FActorSaveData(Actor));
 		ActorSaveData.Transform = Actor->GetTransform();
 
-		TArray<FObjectSaveData>& ComponentsSaveData = ActorSaveData.ComponentsSaveData;
-		ComponentsSaveData.Empty();
-		
 		for (UActorComponent* ActorComponent : Actor->GetComponents())
 		{
 			if (ActorComponent->Implements<USaveSubsystemInterface>())
 			{
-				FObjectSaveData& ComponentSaveData = ComponentsSaveData[ComponentsSaveData.Emplace(ActorComponent)];
+				FObjectSaveData& ComponentSaveData = ActorSaveData.AddComponentSaveData(FObjectSaveData(ActorComponent));
 				FMemoryWriter MemoryWriter(ComponentSaveData.RawData, true);
-				FSaveSubsystemArchive Archive(MemoryWriter, false);
+				FSaveSubsystemArchive Archive(MemoryWriter, GameSaveData.NameTable);
 				ActorComponent->Serialize(Archive);
 			}
 		}
 
 		FMemoryWriter MemoryWriter(ActorSaveData.RawData, true);
-		FSaveSubsystemArchive Archive(MemoryWriter, false);
+		FSaveSubsystemArchive Archive(MemoryWriter, GameSaveData.NameTable);
 		
 		Actor->Serialize(Archive);
 	}
@@ -165,7 +234,8 @@ void USaveSubsystem::DeserializeLevel(ULevel* Level, const ULevelStreaming* Stre
 	if (IsValid(StreamingLevel))
 	{
 		const FName LevelName = StreamingLevel->GetWorldAssetPackageFName();
-		LevelSaveData = GameSaveData.StreamingLevels.FindByPredicate([=](const FLevelSaveData& Data) { return Data.Name == LevelName; });
+		DecodeStreamingLevel(LevelName);
+		LevelSaveData = GameSaveData.FindStreamingLevelSaveData(LevelName);
 	}
 	else
 	{
@@ -181,12 +251,10 @@ void USaveSubsystem::DeserializeLevel(ULevel* Level, const ULevelStreaming* Stre
 
 	TArray<AActor*> ActorsToNotify;
 
-	TArray<FActorSaveData*> ActorsSaveData;
-	ActorsSaveData.Reserve(LevelSaveData->ActorsSaveData.Num());
-	for (FActorSaveData& ActorSaveData : LevelSaveData->ActorsSaveData)
-	{
-		ActorsSaveData.Add(&ActorSaveData);
-	}
+	TArray<FActorSaveData>& ActorsSaveData = LevelSaveData->ActorsSaveData;
+
+	// Save data that has no actor in the level yet. These actors will be spawned.
+	TBitArray<> ActorsToSpawn(true, ActorsSaveData.Num());
 
 	for (TArray<AActor*>::TIterator ActorIterator = Level->Actors.CreateIterator(); ActorIterator; ++ActorIterator)
 	{
@@ -197,14 +265,11 @@ void USaveSubsystem::DeserializeLevel(ULevel* Level, const ULevelStreaming* Stre
 		}
 
 		FActorSaveData* ActorSaveData = nullptr;
-		for (TArray<FActorSaveData*>::TIterator ActorSaveDataIterator = ActorsSaveData.CreateIterator(); ActorSaveDataIterator; ++ActorSaveDataIterator)
+		const int32 ActorIndex = LevelSaveData->FindActorIndex(Actor->GetFName());
+		if (ActorIndex != INDEX_NONE && ActorsToSpawn[ActorIndex])
 		{
-			if ((*ActorSaveDataIterator)->Name == Actor->GetFName())
-			{
-				ActorSaveData = *ActorSaveDataIterator;
-				ActorSaveDataIterator.RemoveCurrent();
-				break;
-			}
+			ActorSaveData = &ActorsSaveData[ActorIndex];
+			ActorsToSpawn[ActorIndex] = false;
 		}
 
 		if (ActorSaveData == nullptr)
@@ -230,8 +295,11 @@ void USaveSubsystem::DeserializeLevel(ULevel* Level, const ULevelStreaming* Stre
 	ActorSpawnParameters.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
 	ActorSpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-	for (FActorSaveData* ActorSaveData : ActorsSaveData)
+	for (TConstSetBitIterator<> ActorToSpawnIterator(ActorsToSpawn); ActorToSpawnIterator; ++ActorToSpawnIterator)
 	{
+		const int32 ActorIndex = ActorToSpawnIterator.GetIndex();
+		FActorSaveData* ActorSaveData = &ActorsSaveData[ActorIndex];
+
 		UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::DeserializeLevel(): %s, Spawn new actor with name: %s"), *GetNameSafe(this), *ActorSaveData->Name.ToString());
 
 		ActorSpawnParameters.Name = ActorSaveData->Name;
@@ -249,7 +317,10 @@ void USaveSubsystem::DeserializeLevel(ULevel* Level, const ULevelStreaming* Stre
 		}
 
 		// Actor name can change so update it.
-		ActorSaveData->Name = Actor->GetFName();
+		if (!LevelSaveData->RenameActorSaveData(ActorIndex, Actor->GetFName()))
+		{
+			UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::DeserializeLevel(): %s, Spawned actor name %s is used by other actor data, keep name %s"), *GetNameSafe(this), *Actor->GetName(), *ActorSaveData->Name.ToString());
+		}
 
 		DeserializeActor(Actor, ActorSaveData);
 
@@ -325,7 +396,7 @@ void USaveSubsystem::SerializeGame()
 	UGameInstance* GameInstance = GetGameInstance();
 	GameSaveData.GameInstance = FObjectSaveData(GetGameInstance());
 	FMemoryWriter MemoryWriter(GameSaveData.GameInstance.RawData, true);
-	FSaveSubsystemArchive Archive(MemoryWriter, false);
+	FSaveSubsystemArchive Archive(MemoryWriter, GameSaveData.NameTable);
 	GameInstance->Serialize(Archive);
 
 	const UWorld* World = GetWorld();
@@ -361,7 +432,7 @@ void USaveSubsystem::DeserializeGame()
 
 	UGameInstance* GameInstance = GetGameInstance();
 	FMemoryReader MemoryReader(GameSaveData.GameInstance.RawData, true);
-	FSaveSubsystemArchive Archive(MemoryReader, false);
+	FSaveSubsystemArchive Archive(MemoryReader, GameSaveData.NameTable);
 	GameInstance->Serialize(Archive);
 
 	const UWorld* World = GetWorld();
@@ -382,66 +453,378 @@ void USaveSubsystem::WriteSaveToFile()
 {
 	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::WriteSaveToFile(): %s"), *GetNameSafe(this));
 
+	// Waiting can fail the save the next delta save would be based on, so it is done before the delta save is made.
+	if (bUseAsyncSaves && PendingSaves.Num() >= MaxPendingSaves)
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::WriteSaveToFile(): %s, Too many pending saves! Wait for SaveId %i"), *GetNameSafe(this), PendingSaves[0].SaveId);
+		WaitForPendingSave(PendingSaves[0].SaveId);
+	}
+
+	// New save always gets a new id, so a save that is still in flight is never overwritten.
 	const int32 SaveId = GetNextSaveId();
 	SaveIds.AddUnique(SaveId);
 
 	GameSaveData.Name = FName(FString::FromInt(SaveId));
 
-	TArray<uint8> SaveBytes;
-	FMemoryWriter MemoryWriter(SaveBytes);
-	FObjectAndNameAsStringProxyArchive WriterArchive(MemoryWriter, false);
-	GameSaveData.Serialize(WriterArchive);
+	const bool bIsDeltaSave = bUseDeltaSaves && LastSaveId != 0 && LastSaveDeltaChainLength < MaxDeltaChainLength;
+	GameSaveData.PreviousSaveId = bIsDeltaSave ? LastSaveId : 0;
+	GameSaveData.DeltaChainLength = bIsDeltaSave ? LastSaveDeltaChainLength + 1 : 0;
 
-	FArchive* FileWriter = IFileManager::Get().CreateFileWriter(*GetSaveFilePath(SaveId));
+	if (!bIsDeltaSave)
+	{
+		// Full save must contain all levels, not only the ones that were shown since load.
+		DecodePendingStreamingLevels();
+	}
 
-	if (bUseCompressedSaves)
+	FGameSaveData DeltaSaveData;
+	if (bUseDeltaSaves)
 	{
-		TArray<uint8> CompressedSaveBytes;
-		FArchiveSaveCompressedProxy CompressedArchive(CompressedSaveBytes, NAME_Zlib);
-		CompressedArchive << SaveBytes;
-		CompressedArchive.Flush();
+		TMap<FName, FLevelSaveDataHashes> SaveDataHashes;
+		GetSaveDataHashes(GameSaveData, SaveDataHashes);
 
-		*FileWriter << CompressedSaveBytes;
+		if (bIsDeltaSave)
+		{
+			MakeDeltaSaveData(SaveDataHashes, DeltaSaveData);
+		}
+
+		LastSaveHashes = MoveTemp(SaveDataHashes);
+		LastSaveId = SaveId;
+		LastSaveDeltaChainLength = GameSaveData.DeltaChainLength;
 	}
-	else
+
+	FGameSaveData& SaveDataToWrite = bIsDeltaSave ? DeltaSaveData : GameSaveData;
+
+	if (bUseAsyncSaves)
+	{
+		WriteSaveToFileAsync(SaveId, SaveDataToWrite);
+		return;
+	}
+
+	const bool bIsSuccess = WriteSaveDataToFile(SaveDataToWrite, GetSaveFilePath(SaveId), SaveCompressionFormat, SaveCompressionBlockSize);
+	if (!bIsSuccess)
+	{
+		ResetDeltaSaves();
+	}
+
+	OnSaveWritten.Broadcast(SaveId, bIsSuccess);
+
+}
+
+void USaveSubsystem::WriteSaveToFileAsync(int32 SaveId, const FGameSaveData& SaveData)
+{
+	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::WriteSaveToFileAsync(): %s, SaveId %i"), *GetNameSafe(this), SaveId);
+
+	// Delta save is valid only if its base save is written, so it is tracked until then.
+	const int32 BaseSaveId = SaveData.PreviousSaveId;
+	if (BaseSaveId != 0 && (DependentSaveBaseIds.Contains(BaseSaveId) || PendingSaves.ContainsByPredicate([=](const FPendingSave& PendingSave) { return PendingSave.SaveId == BaseSaveId; })))
+	{
+		DependentSaveBaseIds.Add(SaveId, BaseSaveId);
+	}
+
+	// Snapshot is copied on the game thread and must be released on the game thread too, because it holds strong object pointers.
+	TSharedPtr<FGameSaveData, ESPMode::ThreadSafe> SaveDataSnapshot = MakeShared<FGameSaveData, ESPMode::ThreadSafe>(SaveData);
+	const FString FilePath = GetSaveFilePath(SaveId);
+	const FName CompressionFormat = SaveCompressionFormat;
+	const int32 CompressionBlockSize = SaveCompressionBlockSize;
+	TWeakObjectPtr<USaveSubsystem> WeakThis(this);
+
+	FPendingSave& PendingSave = PendingSaves.AddDefaulted_GetRef();
+	PendingSave.SaveId = SaveId;
+	PendingSave.Result = Async(EAsyncExecution::ThreadPool, [WeakThis, SaveDataSnapshot, FilePath, CompressionFormat, CompressionBlockSize, SaveId]() mutable
+	{
+		const bool bIsSuccess = WriteSaveDataToFile(*SaveDataSnapshot, FilePath, CompressionFormat, CompressionBlockSize);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, SaveDataSnapshot = MoveTemp(SaveDataSnapshot), SaveId, bIsSuccess]()
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->OnSaveWriteCompleted(SaveId, bIsSuccess);
+			}
+		});
+
+		return bIsSuccess;
+	});
+
+}
+
+void USaveSubsystem::WaitForPendingSave(int32 SaveId)
+{
+	const int32 PendingSaveIndex = PendingSaves.IndexOfByPredicate([=](const FPendingSave& PendingSave) { return PendingSave.SaveId == SaveId; });
+	if (PendingSaveIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::WaitForPendingSave(): %s, SaveId %i"), *GetNameSafe(this), SaveId);
+
+	const bool bIsSuccess = PendingSaves[PendingSaveIndex].Result.Get();
+	OnSaveWriteCompleted(SaveId, bIsSuccess);
+
+}
+
+void USaveSubsystem::WaitForPendingSaves()
+{
+	while (PendingSaves.Num() > 0)
+	{
+		WaitForPendingSave(PendingSaves[0].SaveId);
+	}
+}
+
+void USaveSubsystem::OnSaveWriteCompleted(int32 SaveId, bool bIsSuccess)
+{
+	// Completion can be reported twice: by WaitForPendingSave() and by the game thread task. Handle only the first one.
+	const int32 RemovedCount = PendingSaves.RemoveAll([=](const FPendingSave& PendingSave) { return PendingSave.SaveId == SaveId; });
+	if (RemovedCount == 0)
+	{
+		return;
+	}
+
+	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::OnSaveWriteCompleted(): %s, SaveId %i, Success %i"), *GetNameSafe(this), SaveId, bIsSuccess);
+
+	if (!bIsSuccess)
+	{
+		SaveIds.Remove(SaveId);
+		DependentSaveBaseIds.Remove(SaveId);
+
+		// Next delta saves can't be based on the failed save.
+		ResetDeltaSaves();
+
+		OnSaveWritten.Broadcast(SaveId, false);
+		DiscardDependentSaves(SaveId);
+		return;
+	}
+
+	// Save which base is not written yet is confirmed together with its base.
+	if (!DependentSaveBaseIds.Contains(SaveId))
+	{
+		ConfirmDependentSaves(SaveId);
+	}
+
+	OnSaveWritten.Broadcast(SaveId, true);
+
+}
+
+void USaveSubsystem::DiscardDependentSaves(int32 FailedSaveId)
+{
+	TArray<int32> DependentSaveIds;
+	for (const TPair<int32, int32>& DependentSaveBaseId : DependentSaveBaseIds)
+	{
+		if (DependentSaveBaseId.Value == FailedSaveId)
+		{
+			DependentSaveIds.Add(DependentSaveBaseId.Key);
+		}
+	}
+
+	for (int32 DependentSaveId : DependentSaveIds)
+	{
+		DependentSaveBaseIds.Remove(DependentSaveId);
+
+		// File of a pending save is deleted only after it is written, its completion is not reported anymore.
+		const int32 PendingSaveIndex = PendingSaves.IndexOfByPredicate([=](const FPendingSave& PendingSave) { return PendingSave.SaveId == DependentSaveId; });
+		if (PendingSaveIndex != INDEX_NONE)
+		{
+			PendingSaves[PendingSaveIndex].Result.Wait();
+			PendingSaves.RemoveAt(PendingSaveIndex);
+		}
+
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::DiscardDependentSaves(): %s, SaveId %i is based on failed SaveId %i"), *GetNameSafe(this), DependentSaveId, FailedSaveId);
+
+		IFileManager::Get().Delete(*GetSaveFilePath(DependentSaveId));
+		SaveIds.Remove(DependentSaveId);
+		OnSaveWritten.Broadcast(DependentSaveId, false);
+
+		DiscardDependentSaves(DependentSaveId);
+	}
+}
+
+void USaveSubsystem::ConfirmDependentSaves(int32 WrittenSaveId)
+{
+	TArray<int32> DependentSaveIds;
+	for (const TPair<int32, int32>& DependentSaveBaseId : DependentSaveBaseIds)
 	{
-		*FileWriter << SaveBytes;
+		if (DependentSaveBaseId.Value == WrittenSaveId)
+		{
+			DependentSaveIds.Add(DependentSaveBaseId.Key);
+		}
 	}
 
-	FileWriter->Close();
-	delete FileWriter;
+	for (int32 DependentSaveId : DependentSaveIds)
+	{
+		DependentSaveBaseIds.Remove(DependentSaveId);
 
+		// Dependent save that is written already confirms its own dependents. Pending one does it when it is written.
+		if (!PendingSaves.ContainsByPredicate([=](const FPendingSave& PendingSave) { return PendingSave.SaveId == DependentSaveId; }))
+		{
+			ConfirmDependentSaves(DependentSaveId);
+		}
+	}
 }
 
-void USaveSubsystem::LoadSaveFromFile(int32 SaveId)
+bool USaveSubsystem::LoadSaveFromFile(int32 SaveId)
 {
 	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::LoadSaveFromFile(): %s, SaveId %i"), *GetNameSafe(this), SaveId);
 
-	FArchive* FileReader = IFileManager::Get().CreateFileReader(*GetSaveFilePath(SaveId));
-	TArray<uint8> SaveBytes;
+	// Only game data and persistent level are decoded here. Streaming levels are decoded when they are shown.
+	TArray<TUniquePtr<FSaveFileReader>> SaveFiles;
+	FGameSaveData LoadedSaveData;
+	if (!OpenSaveChain(SaveId, SaveFiles, LoadedSaveData))
+	{
+		return false;
+	}
+
+	ReleaseSaveFiles();
+
+	GameSaveData = MoveTemp(LoadedSaveData);
+	LoadedSaveFiles = MoveTemp(SaveFiles);
 
-	if (bUseCompressedSaves)
+	TArray<FName> LevelNames;
+	for (const TUniquePtr<FSaveFileReader>& SaveFile : LoadedSaveFiles)
 	{
-		TArray<uint8> CompressedSaveBytes;
-		*FileReader << CompressedSaveBytes;
+		SaveFile->GetStreamingLevelNames(LevelNames);
+	}
+	PendingStreamingLevels.Append(LevelNames);
 
-		FArchiveLoadCompressedProxy DecompressedArchive(CompressedSaveBytes, NAME_Zlib);
-		DecompressedArchive << SaveBytes;
-		DecompressedArchive.Flush();
+	if (bUseDeltaSaves)
+	{
+		// Hashes of streaming levels are added when they are decoded.
+		GetSaveDataHashes(GameSaveData, LastSaveHashes);
+		LastSaveId = SaveId;
+		LastSaveDeltaChainLength = GameSaveData.DeltaChainLength;
 	}
-	else
+
+	if (PendingStreamingLevels.Num() == 0)
 	{
-		*FileReader << SaveBytes;
+		ReleaseSaveFiles();
 	}
 
-	FileReader->Close();
-	delete FileReader;
+	return true;
 
-	FMemoryReader MemoryReader(SaveBytes, true);
-	FObjectAndNameAsStringProxyArchive ReaderArchive(MemoryReader, true);
-	GameSaveData = FGameSaveData();
-	GameSaveData.Serialize(ReaderArchive);
+}
+
+bool USaveSubsystem::OpenSaveChain(int32 SaveId, TArray<TUniquePtr<FSaveFileReader>>& OutSaveFiles, FGameSaveData& OutSaveData)
+{
+	// Open saves back to the last full save, then apply delta saves on top of it in order.
+	TArray<FGameSaveData> SaveDataChain;
+	int32 CurrentSaveId = SaveId;
+	while (CurrentSaveId > 0)
+	{
+		WaitForPendingSave(CurrentSaveId);
+
+		TUniquePtr<FSaveFileReader> SaveFile = MakeUnique<FSaveFileReader>();
+		FGameSaveData& SaveData = SaveDataChain.AddDefaulted_GetRef();
+		if (!SaveFile->Open(GetSaveFilePath(CurrentSaveId)) || !SaveFile->ReadGameData(SaveData))
+		{
+			UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::OpenSaveChain(): %s, Failed to read save %i"), *GetNameSafe(this), CurrentSaveId);
+			return false;
+		}
+
+		if (SaveData.PreviousSaveId >= CurrentSaveId)
+		{
+			UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::OpenSaveChain(): %s, Save %i has invalid previous save %i"), *GetNameSafe(this), CurrentSaveId, SaveData.PreviousSaveId);
+			return false;
+		}
+
+		OutSaveFiles.Insert(MoveTemp(SaveFile), 0);
+		CurrentSaveId = SaveData.PreviousSaveId;
+	}
+
+	if (SaveDataChain.Num() == 0)
+	{
+		return false;
+	}
+
+	OutSaveData = MoveTemp(SaveDataChain.Last());
+	for (int32 i = SaveDataChain.Num() - 2; i >= 0; --i)
+	{
+		ApplyDeltaSaveData(OutSaveData, SaveDataChain[i]);
+	}
+
+	return true;
+}
+
+bool USaveSubsystem::ReadSaveChainFromFile(int32 SaveId, FGameSaveData& OutSaveData)
+{
+	TArray<TUniquePtr<FSaveFileReader>> SaveFiles;
+	if (!OpenSaveChain(SaveId, SaveFiles, OutSaveData))
+	{
+		return false;
+	}
+
+	TArray<FName> LevelNames;
+	for (const TUniquePtr<FSaveFileReader>& SaveFile : SaveFiles)
+	{
+		LevelNames.Reset();
+		SaveFile->GetStreamingLevelNames(LevelNames);
+		for (const FName& LevelName : LevelNames)
+		{
+			FLevelSaveData LevelSaveData;
+			if (!SaveFile->ReadStreamingLevel(LevelName, LevelSaveData))
+			{
+				UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::ReadSaveChainFromFile(): %s, Failed to read level %s of save %i"), *GetNameSafe(this), *LevelName.ToString(), SaveId);
+				return false;
+			}
+
+			ApplyDeltaLevelSaveData(OutSaveData.FindOrAddStreamingLevelSaveData(LevelName), LevelSaveData);
+		}
+	}
 
+	return true;
+}
+
+void USaveSubsystem::DecodeStreamingLevel(const FName& LevelName)
+{
+	if (PendingStreamingLevels.Remove(LevelName) == 0)
+	{
+		return;
+	}
+
+	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::DecodeStreamingLevel(): %s, Level %s"), *GetNameSafe(this), *LevelName.ToString());
+
+	FLevelSaveData* LevelSaveData = nullptr;
+	for (const TUniquePtr<FSaveFileReader>& SaveFile : LoadedSaveFiles)
+	{
+		if (!SaveFile->HasStreamingLevel(LevelName))
+		{
+			continue;
+		}
+
+		FLevelSaveData DeltaLevelSaveData;
+		if (!SaveFile->ReadStreamingLevel(LevelName, DeltaLevelSaveData))
+		{
+			// Later delta saves can't be applied without this one.
+			UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::DecodeStreamingLevel(): %s, Failed to read level %s"), *GetNameSafe(this), *LevelName.ToString());
+			break;
+		}
+
+		LevelSaveData = &GameSaveData.FindOrAddStreamingLevelSaveData(LevelName);
+		ApplyDeltaLevelSaveData(*LevelSaveData, DeltaLevelSaveData);
+	}
+
+	if (LevelSaveData != nullptr && bUseDeltaSaves && LastSaveId != 0)
+	{
+		GetLevelSaveDataHashes(*LevelSaveData, LastSaveHashes.Add(LevelName));
+	}
+
+	if (PendingStreamingLevels.Num() == 0)
+	{
+		ReleaseSaveFiles();
+	}
+
+}
+
+void USaveSubsystem::DecodePendingStreamingLevels()
+{
+	const TArray<FName> LevelNames = PendingStreamingLevels.Array();
+	for (const FName& LevelName : LevelNames)
+	{
+		DecodeStreamingLevel(LevelName);
+	}
+}
+
+void USaveSubsystem::ReleaseSaveFiles()
+{
+	LoadedSaveFiles.Empty();
+	PendingStreamingLevels.Empty();
 }
 
 void USaveSubsystem::OnPostLoadMapWithWorld(UWorld* LoadedWorld)
@@ -460,20 +843,25 @@ void USaveSubsystem::DeserializeActor(AActor* Actor, const FActorSaveData* Actor
 
 	Actor->SetActorTransform(ActorSaveData->Transform);
 
-	const TArray<FObjectSaveData>& ComponentsSaveData = ActorSaveData->ComponentsSaveData;
 	for (UActorComponent* ActorComponent : Actor->GetComponents())
 	{
 		if (ActorComponent->Implements<USaveSubsystemInterface>())
 		{
-			const FObjectSaveData* ComponentSaveData = ComponentsSaveData.FindByPredicate([=](const FObjectSaveData& SaveData) { return SaveData.Name == ActorComponent->GetFName(); });
+			const FObjectSaveData* ComponentSaveData = ActorSaveData->FindComponentSaveData(ActorComponent->GetFName());
+			if (ComponentSaveData == nullptr)
+			{
+				UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::DeserializeActor(): %s, ComponentSaveData not found for %s"), *GetNameSafe(this), *GetNameSafe(ActorComponent));
+				continue;
+			}
+
 			FMemoryReader MemoryReader(ComponentSaveData->RawData, true);
-			FSaveSubsystemArchive Archive(MemoryReader, false);
+			FSaveSubsystemArchive Archive(MemoryReader, GameSaveData.NameTable);
 			ActorComponent->Serialize(Archive);
 		}
 	}
 
 	FMemoryReader MemoryReader(ActorSaveData->RawData, true);
-	FSaveSubsystemArchive Archive(MemoryReader, false);
+	FSaveSubsystemArchive Archive(MemoryReader, GameSaveData.NameTable);
 	Actor->Serialize(Archive);
 }
 
@@ -492,6 +880,227 @@ int32 USaveSubsystem::GetNextSaveId() const
 	return SaveIds[SaveIds.Num() - 1] + 1;
 }
 
+bool USaveSubsystem::WriteSaveDataToFile(FGameSaveData& SaveData, const FString& FilePath, FName CompressionFormat, int32 CompressionBlockSize)
+{
+	// Can be called from a worker thread.
+	// Write to temporary file first, so the save file is never seen half written.
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	const bool bIsWritten = FSaveFileWriter::Write(SaveData, TempFilePath, CompressionFormat, CompressionBlockSize);
+
+	if (!bIsWritten || !IFileManager::Get().Move(*FilePath, *TempFilePath))
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::WriteSaveDataToFile(): Failed to write file %s"), *FilePath);
+		IFileManager::Get().Delete(*TempFilePath);
+		return false;
+	}
+
+	return true;
+}
+
+void USaveSubsystem::MakeDeltaSaveData(const TMap<FName, FLevelSaveDataHashes>& SaveDataHashes, FGameSaveData& OutDeltaSaveData) const
+{
+	OutDeltaSaveData.Name = GameSaveData.Name;
+	OutDeltaSaveData.LevelName = GameSaveData.LevelName;
+	OutDeltaSaveData.GameInstance = GameSaveData.GameInstance;
+	OutDeltaSaveData.StartTransform = GameSaveData.StartTransform;
+	OutDeltaSaveData.PreviousSaveId = GameSaveData.PreviousSaveId;
+	OutDeltaSaveData.DeltaChainLength = GameSaveData.DeltaChainLength;
+	OutDeltaSaveData.NameTable = GameSaveData.NameTable;
+
+	MakeDeltaLevelSaveData(GameSaveData.PersistentLevel, SaveDataHashes.FindChecked(GameSaveData.PersistentLevel.Name), OutDeltaSaveData.PersistentLevel);
+
+	for (const FLevelSaveData& LevelSaveData : GameSaveData.StreamingLevels)
+	{
+		FLevelSaveData DeltaLevelSaveData(LevelSaveData.Name);
+		MakeDeltaLevelSaveData(LevelSaveData, SaveDataHashes.FindChecked(LevelSaveData.Name), DeltaLevelSaveData);
+
+		// Level that is new for this save must be stored even if empty, so its actors are not kept on load.
+		const bool bIsNewLevel = !LastSaveHashes.Contains(LevelSaveData.Name);
+		if (bIsNewLevel || DeltaLevelSaveData.ActorsSaveData.Num() > 0 || DeltaLevelSaveData.RemovedActors.Num() > 0)
+		{
+			OutDeltaSaveData.StreamingLevels.Add(MoveTemp(DeltaLevelSaveData));
+		}
+	}
+
+}
+
+void USaveSubsystem::MakeDeltaLevelSaveData(const FLevelSaveData& LevelSaveData, const FLevelSaveDataHashes& LevelSaveDataHashes, FLevelSaveData& OutDeltaLevelSaveData) const
+{
+	const FLevelSaveDataHashes* LastLevelSaveDataHashes = LastSaveHashes.Find(LevelSaveData.Name);
+	if (LastLevelSaveDataHashes == nullptr)
+	{
+		OutDeltaLevelSaveData = LevelSaveData;
+		return;
+	}
+
+	for (const FActorSaveData& ActorSaveData : LevelSaveData.ActorsSaveData)
+	{
+		const uint32* LastActorHash = LastLevelSaveDataHashes->ActorHashes.Find(ActorSaveData.Name);
+		if (LastActorHash == nullptr)
+		{
+			OutDeltaLevelSaveData.ActorsSaveData.Add(ActorSaveData);
+			continue;
+		}
+
+		const bool bIsActorChanged = *LastActorHash != LevelSaveDataHashes.ActorHashes.FindChecked(ActorSaveData.Name);
+
+		const TMap<FName, uint32>& ComponentHashes = LevelSaveDataHashes.ComponentHashes.FindChecked(ActorSaveData.Name);
+		const TMap<FName, uint32>* LastComponentHashes = LastLevelSaveDataHashes->ComponentHashes.Find(ActorSaveData.Name);
+
+		TArray<const FObjectSaveData*> ChangedComponents;
+		for (const FObjectSaveData& ComponentSaveData : ActorSaveData.ComponentsSaveData)
+		{
+			const uint32* LastComponentHash = LastComponentHashes != nullptr ? LastComponentHashes->Find(ComponentSaveData.Name) : nullptr;
+			if (LastComponentHash == nullptr || *LastComponentHash != ComponentHashes.FindChecked(ComponentSaveData.Name))
+			{
+				ChangedComponents.Add(&ComponentSaveData);
+			}
+		}
+
+		TArray<FName> RemovedComponents;
+		if (LastComponentHashes != nullptr)
+		{
+			for (const TPair<FName, uint32>& LastComponentHash : *LastComponentHashes)
+			{
+				if (!ComponentHashes.Contains(LastComponentHash.Key))
+				{
+					RemovedComponents.Add(LastComponentHash.Key);
+				}
+			}
+		}
+
+		if (!bIsActorChanged && ChangedComponents.Num() == 0 && RemovedComponents.Num() == 0)
+		{
+			continue;
+		}
+
+		FActorSaveData& DeltaActorSaveData = OutDeltaLevelSaveData.ActorsSaveData.AddDefaulted_GetRef();
+		DeltaActorSaveData.Name = ActorSaveData.Name;
+		DeltaActorSaveData.Class = ActorSaveData.Class;
+		DeltaActorSaveData.bIsPartial = !bIsActorChanged;
+		DeltaActorSaveData.RemovedComponents = MoveTemp(RemovedComponents);
+		if (bIsActorChanged)
+		{
+			DeltaActorSaveData.RawData = ActorSaveData.RawData;
+			DeltaActorSaveData.Transform = ActorSaveData.Transform;
+		}
+
+		DeltaActorSaveData.ComponentsSaveData.Reserve(ChangedComponents.Num());
+		for (const FObjectSaveData* ComponentSaveData : ChangedComponents)
+		{
+			DeltaActorSaveData.ComponentsSaveData.Add(*ComponentSaveData);
+		}
+	}
+
+	for (const TPair<FName, uint32>& LastActorHash : LastLevelSaveDataHashes->ActorHashes)
+	{
+		if (!LevelSaveDataHashes.ActorHashes.Contains(LastActorHash.Key))
+		{
+			OutDeltaLevelSaveData.RemovedActors.Add(LastActorHash.Key);
+		}
+	}
+
+}
+
+void USaveSubsystem::ResetDeltaSaves()
+{
+	LastSaveHashes.Empty();
+	LastSaveId = 0;
+	LastSaveDeltaChainLength = 0;
+}
+
+void USaveSubsystem::GetSaveDataHashes(const FGameSaveData& SaveData, TMap<FName, FLevelSaveDataHashes>& OutSaveDataHashes)
+{
+	OutSaveDataHashes.Empty(SaveData.StreamingLevels.Num() + 1);
+
+	GetLevelSaveDataHashes(SaveData.PersistentLevel, OutSaveDataHashes.Add(SaveData.PersistentLevel.Name));
+	for (const FLevelSaveData& LevelSaveData : SaveData.StreamingLevels)
+	{
+		GetLevelSaveDataHashes(LevelSaveData, OutSaveDataHashes.Add(LevelSaveData.Name));
+	}
+}
+
+void USaveSubsystem::GetLevelSaveDataHashes(const FLevelSaveData& LevelSaveData, FLevelSaveDataHashes& OutLevelSaveDataHashes)
+{
+	OutLevelSaveDataHashes.ActorHashes.Reserve(LevelSaveData.ActorsSaveData.Num());
+	OutLevelSaveDataHashes.ComponentHashes.Reserve(LevelSaveData.ActorsSaveData.Num());
+
+	for (const FActorSaveData& ActorSaveData : LevelSaveData.ActorsSaveData)
+	{
+		OutLevelSaveDataHashes.ActorHashes.Add(ActorSaveData.Name, ActorSaveData.GetDataHash());
+
+		TMap<FName, uint32>& ComponentHashes = OutLevelSaveDataHashes.ComponentHashes.Add(ActorSaveData.Name);
+		ComponentHashes.Reserve(ActorSaveData.ComponentsSaveData.Num());
+		for (const FObjectSaveData& ComponentSaveData : ActorSaveData.ComponentsSaveData)
+		{
+			ComponentHashes.Add(ComponentSaveData.Name, ComponentSaveData.GetDataHash());
+		}
+	}
+}
+
+void USaveSubsystem::ApplyDeltaSaveData(FGameSaveData& SaveData, const FGameSaveData& DeltaSaveData)
+{
+	SaveData.Name = DeltaSaveData.Name;
+	SaveData.LevelName = DeltaSaveData.LevelName;
+	SaveData.GameInstance = DeltaSaveData.GameInstance;
+	SaveData.StartTransform = DeltaSaveData.StartTransform;
+	SaveData.PreviousSaveId = DeltaSaveData.PreviousSaveId;
+	SaveData.DeltaChainLength = DeltaSaveData.DeltaChainLength;
+	// Name table of a later save extends the earlier one.
+	SaveData.NameTable = DeltaSaveData.NameTable;
+
+	ApplyDeltaLevelSaveData(SaveData.PersistentLevel, DeltaSaveData.PersistentLevel);
+
+	for (const FLevelSaveData& DeltaLevelSaveData : DeltaSaveData.StreamingLevels)
+	{
+		ApplyDeltaLevelSaveData(SaveData.FindOrAddStreamingLevelSaveData(DeltaLevelSaveData.Name), DeltaLevelSaveData);
+	}
+}
+
+void USaveSubsystem::ApplyDeltaLevelSaveData(FLevelSaveData& LevelSaveData, const FLevelSaveData& DeltaLevelSaveData)
+{
+	if (DeltaLevelSaveData.RemovedActors.Num() > 0)
+	{
+		const TSet<FName> RemovedActors(DeltaLevelSaveData.RemovedActors);
+		LevelSaveData.ActorsSaveData.RemoveAll([&](const FActorSaveData& ActorSaveData) { return RemovedActors.Contains(ActorSaveData.Name); });
+		LevelSaveData.BuildActorIndex();
+	}
+
+	for (const FActorSaveData& DeltaActorSaveData : DeltaLevelSaveData.ActorsSaveData)
+	{
+		FActorSaveData* ActorSaveData = LevelSaveData.FindActorSaveData(DeltaActorSaveData.Name);
+		if (ActorSaveData == nullptr)
+		{
+			UE_CLOG(DeltaActorSaveData.bIsPartial, LogSaveSubsystem, Warning, TEXT("USaveSubsystem::ApplyDeltaLevelSaveData(): Partial data for unknown actor %s"), *DeltaActorSaveData.Name.ToString());
+			LevelSaveData.AddActorSaveData(DeltaActorSaveData);
+			continue;
+		}
+
+		if (!DeltaActorSaveData.bIsPartial)
+		{
+			ActorSaveData->Class = DeltaActorSaveData.Class;
+			ActorSaveData->RawData = DeltaActorSaveData.RawData;
+			ActorSaveData->Transform = DeltaActorSaveData.Transform;
+		}
+
+		// Components destroyed since the base save must not come back on load.
+		ActorSaveData->RemoveComponentsSaveData(DeltaActorSaveData.RemovedComponents);
+
+		for (const FObjectSaveData& DeltaComponentSaveData : DeltaActorSaveData.ComponentsSaveData)
+		{
+			FObjectSaveData* ComponentSaveData = ActorSaveData->FindComponentSaveData(DeltaComponentSaveData.Name);
+			if (ComponentSaveData == nullptr)
+			{
+				ActorSaveData->AddComponentSaveData(DeltaComponentSaveData);
+			}
+			else
+			{
+				*ComponentSaveData = DeltaComponentSaveData;
+			}
+		}
+	}
+}
+
 void USaveSubsystem::OnActorSpawned(AActor* SpawnedActor)
 {
 	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::OnActorSpawned(): %s, Actor %s"), *GetNameSafe(this), *GetNameSafe(SpawnedActor));
@@ -522,3 +1131,127 @@ void USaveSubsystem::NotifyActorsAndComponents(AActor* Actor)
 	}
 }
 
+void USaveSubsystem::BenchmarkSaveActorLookup()
+{
+#if !UE_BUILD_SHIPPING
+	const TArray<int32> ActorCounts = { 1000, 10000, 50000 };
+	for (const int32 ActorCount : ActorCounts)
+	{
+		FLevelSaveData LevelSaveData(FName(TEXT("Benchmark")));
+		TArray<FName> ActorNames;
+		ActorNames.Reserve(ActorCount);
+		for (int32 i = 0; i < ActorCount; ++i)
+		{
+			FActorSaveData ActorSaveData;
+			ActorSaveData.Name = FName(TEXT("BenchmarkActor"), i + 1);
+			ActorNames.Add(ActorSaveData.Name);
+			LevelSaveData.ActorsSaveData.Add(ActorSaveData);
+		}
+
+		// Level actors order usually differs from the saved one.
+		FRandomStream RandomStream(ActorCount);
+		for (int32 i = ActorNames.Num() - 1; i > 0; --i)
+		{
+			ActorNames.Swap(i, RandomStream.RandRange(0, i));
+		}
+
+		// Lookup as it was done before indices: linear search with removal of found data.
+		double StartTime = FPlatformTime::Seconds();
+		TArray<FActorSaveData*> ActorsSaveData;
+		ActorsSaveData.Reserve(LevelSaveData.ActorsSaveData.Num());
+		for (FActorSaveData& ActorSaveData : LevelSaveData.ActorsSaveData)
+		{
+			ActorsSaveData.Add(&ActorSaveData);
+		}
+
+		int32 LinearFoundCount = 0;
+		for (const FName& ActorName : ActorNames)
+		{
+			for (TArray<FActorSaveData*>::TIterator ActorSaveDataIterator = ActorsSaveData.CreateIterator(); ActorSaveDataIterator; ++ActorSaveDataIterator)
+			{
+				if ((*ActorSaveDataIterator)->Name == ActorName)
+				{
+					ActorSaveDataIterator.RemoveCurrent();
+					++LinearFoundCount;
+					break;
+				}
+			}
+		}
+		const double LinearTime = FPlatformTime::Seconds() - StartTime;
+
+		// Indexed lookup, including index build that is done once on load.
+		StartTime = FPlatformTime::Seconds();
+		LevelSaveData.BuildActorIndex();
+		TBitArray<> ActorsToSpawn(true, LevelSaveData.ActorsSaveData.Num());
+		int32 IndexedFoundCount = 0;
+		for (const FName& ActorName : ActorNames)
+		{
+			const int32 ActorIndex = LevelSaveData.FindActorIndex(ActorName);
+			if (ActorIndex != INDEX_NONE && ActorsToSpawn[ActorIndex])
+			{
+				ActorsToSpawn[ActorIndex] = false;
+				++IndexedFoundCount;
+			}
+		}
+		const double IndexedTime = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::BenchmarkSaveActorLookup(): Actors %i, Linear %.3f ms (found %i), Indexed %.3f ms (found %i)"), ActorCount, LinearTime * 1000.0, LinearFoundCount, IndexedTime * 1000.0, IndexedFoundCount);
+	}
+#endif
+}
+
+void USaveSubsystem::BenchmarkSaveCompression(int32 SaveId)
+{
+#if !UE_BUILD_SHIPPING
+	if (SaveId == 0 && SaveIds.Num() > 0)
+	{
+		SaveId = SaveIds[SaveIds.Num() - 1];
+	}
+
+	FGameSaveData SaveData;
+	if (!SaveIds.Contains(SaveId) || !ReadSaveChainFromFile(SaveId, SaveData))
+	{
+		UE_LOG(LogSaveSubsystem, Warning, TEXT("USaveSubsystem::BenchmarkSaveCompression(): Failed to read save %i"), SaveId);
+		return;
+	}
+
+	TArray<uint8> SaveBytes;
+	FMemoryWriter MemoryWriter(SaveBytes);
+	FObjectAndNameAsStringProxyArchive WriterArchive(MemoryWriter, false);
+	SaveData.Serialize(WriterArchive);
+
+	const double SaveSizeMB = SaveBytes.Num() / (1024.0 * 1024.0);
+	UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::BenchmarkSaveCompression(): Save %i, Size %.2f MB, Block size %i"), SaveId, SaveSizeMB, SaveCompressionBlockSize);
+
+	const TArray<FName> CompressionFormats = { NAME_Zlib, NAME_Gzip, NAME_LZ4, FName(TEXT("Oodle")) };
+	for (const FName& CompressionFormat : CompressionFormats)
+	{
+		if (!FCompression::IsFormatValid(CompressionFormat))
+		{
+			UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::BenchmarkSaveCompression(): %s is not available"), *CompressionFormat.ToString());
+			continue;
+		}
+
+		double StartTime = FPlatformTime::Seconds();
+		TArray<uint8> CompressedBytes;
+		TArray<int32> BlockSizes;
+		bool bIsValid = FSaveFileCompression::CompressBlocks(CompressionFormat, SaveCompressionBlockSize, SaveBytes, CompressedBytes, BlockSizes);
+		const double CompressTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		TArray<uint8> UncompressedBytes;
+		UncompressedBytes.SetNumUninitialized(SaveBytes.Num());
+		bIsValid &= FSaveFileCompression::UncompressBlocks(CompressionFormat, SaveCompressionBlockSize, CompressedBytes.GetData(), CompressedBytes.Num(), BlockSizes, UncompressedBytes);
+		const double UncompressTime = FPlatformTime::Seconds() - StartTime;
+
+		bIsValid &= UncompressedBytes == SaveBytes;
+
+		const double Ratio = CompressedBytes.Num() > 0 ? (double)SaveBytes.Num() / CompressedBytes.Num() : 0.0;
+		UE_LOG(LogSaveSubsystem, Display, TEXT("USaveSubsystem::BenchmarkSaveCompression(): %s, Ratio %.2f, Compress %.1f MB/s (%.2f ms), Decompress %.1f MB/s (%.2f ms), Valid %i"),
+			*CompressionFormat.ToString(), Ratio,
+			SaveSizeMB / FMath::Max(CompressTime, SMALL_NUMBER), CompressTime * 1000.0,
+			SaveSizeMB / FMath::Max(UncompressTime, SMALL_NUMBER), UncompressTime * 1000.0,
+			bIsValid);
+	}
+#endif
+}
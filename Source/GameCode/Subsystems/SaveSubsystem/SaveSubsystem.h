@@ -5,11 +5,15 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "SaveData.h"
+#include "SaveSubsystemTypes.h"
+#include "SaveFile.h"
 #include "SaveSubsystem.generated.h"
 
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSaveWritten, int32, bool);
+
 class UStreamingLevelObserver;
 
-UCLASS()
+UCLASS(Config = Game)
 class GAMECODE_API USaveSubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
@@ -26,6 +30,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Save Subsystem")
 	void LoadGame(int32 SaveId);
 
+	/** Folds delta save with all its previous saves into a full save. */
+	UFUNCTION(BlueprintCallable, Category = "Save Subsystem")
+	void CompactSave(int32 SaveId);
+
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
@@ -34,6 +42,18 @@ public:
 	void SerializeLevel(const ULevel* Level, const ULevelStreaming* StreamingLevel = nullptr);
 	void DeserializeLevel(ULevel* Level, const ULevelStreaming* StreamingLevel = nullptr);
 
+	bool IsSaveInProgress() const;
+
+	/** Compression format of new saves. Saves that are already written keep their own format. */
+	UFUNCTION(BlueprintCallable, Category = "Save Subsystem")
+	void SetSaveCompressionFormat(FName CompressionFormat);
+
+	UFUNCTION(BlueprintPure, Category = "Save Subsystem")
+	FName GetSaveCompressionFormat() const;
+
+	/** Called on the game thread when a save file is written. Params: SaveId, bIsSuccess. */
+	FOnSaveWritten OnSaveWritten;
+
 private:
 	void CreateStreamingLevelObservers(UWorld* World);
 	void RemoveStreamingLevelObservers();
@@ -41,14 +61,43 @@ private:
 	void SerializeGame();
 	void DeserializeGame();
 	void WriteSaveToFile();
-	void LoadSaveFromFile(int32 SaveId);
+	void WriteSaveToFileAsync(int32 SaveId, const FGameSaveData& SaveData);
+	void WaitForPendingSave(int32 SaveId);
+	void WaitForPendingSaves();
+	void OnSaveWriteCompleted(int32 SaveId, bool bIsSuccess);
+	/** Deletes saves that are based on the failed save, directly or through other delta saves */
+	void DiscardDependentSaves(int32 FailedSaveId);
+	/** Saves based on the written save can't be discarded anymore, unless they fail themselves */
+	void ConfirmDependentSaves(int32 WrittenSaveId);
+	bool LoadSaveFromFile(int32 SaveId);
+	bool OpenSaveChain(int32 SaveId, TArray<TUniquePtr<FSaveFileReader>>& OutSaveFiles, FGameSaveData& OutSaveData);
+	bool ReadSaveChainFromFile(int32 SaveId, FGameSaveData& OutSaveData);
+	void DecodeStreamingLevel(const FName& LevelName);
+	void DecodePendingStreamingLevels();
+	void ReleaseSaveFiles();
 	void OnPostLoadMapWithWorld(UWorld* LoadedWorld);
 	void DeserializeActor(AActor* Actor, const FActorSaveData* ActorSaveData);
 	FString GetSaveFilePath(int32 SaveId) const;
 	int32 GetNextSaveId() const;
+	static bool WriteSaveDataToFile(FGameSaveData& SaveData, const FString& FilePath, FName CompressionFormat, int32 CompressionBlockSize);
+	void MakeDeltaSaveData(const TMap<FName, FLevelSaveDataHashes>& SaveDataHashes, FGameSaveData& OutDeltaSaveData) const;
+	void MakeDeltaLevelSaveData(const FLevelSaveData& LevelSaveData, const FLevelSaveDataHashes& LevelSaveDataHashes, FLevelSaveData& OutDeltaLevelSaveData) const;
+	void ResetDeltaSaves();
+	static void GetSaveDataHashes(const FGameSaveData& SaveData, TMap<FName, FLevelSaveDataHashes>& OutSaveDataHashes);
+	static void GetLevelSaveDataHashes(const FLevelSaveData& LevelSaveData, FLevelSaveDataHashes& OutLevelSaveDataHashes);
+	static void ApplyDeltaSaveData(FGameSaveData& SaveData, const FGameSaveData& DeltaSaveData);
+	static void ApplyDeltaLevelSaveData(FLevelSaveData& LevelSaveData, const FLevelSaveData& DeltaLevelSaveData);
 	void OnActorSpawned(AActor* SpawnedActor);
 	void NotifyActorsAndComponents(AActor* Actor);
 
+	/** Compares linear and indexed actor save data lookup for levels with 1k, 10k and 50k actors. */
+	UFUNCTION(Exec)
+	void BenchmarkSaveActorLookup();
+
+	/** Reports ratio, MB/s and wall time of every available compression format for save @SaveId or for the last save. */
+	UFUNCTION(Exec)
+	void BenchmarkSaveCompression(int32 SaveId);
+
 	UPROPERTY(Transient)
 	TArray<UStreamingLevelObserver*> StreamingLevelObservers;
 
@@ -57,8 +106,36 @@ private:
 	FString SaveDirectoryName;
 	TArray<int32> SaveIds;
 	FDelegateHandle OnActorSpawnedDelegateHandle;
-
-	bool bUseCompressedSaves = false;
+	TArray<FPendingSave> PendingSaves;
+	/** Delta saves queued while their base save was not written yet, to the id of the base save */
+	TMap<int32, int32> DependentSaveBaseIds;
+
+	/** Files of the loaded save chain, full save first. Kept open while some streaming levels are not decoded. */
+	TArray<TUniquePtr<FSaveFileReader>> LoadedSaveFiles;
+	/** Streaming levels of the loaded save that are decoded when shown */
+	TSet<FName> PendingStreamingLevels;
+
+	/** Hashes of the data written to @LastSaveId. Next delta save stores only data that differs from them. */
+	TMap<FName, FLevelSaveDataHashes> LastSaveHashes;
+	/** Save the next delta save will be based on. 0 means the next save is a full save. */
+	int32 LastSaveId = 0;
+	int32 LastSaveDeltaChainLength = 0;
+
+	/** None, Zlib, Gzip, LZ4, Oodle or any other format registered in FCompression */
+	UPROPERTY(Config)
+	FName SaveCompressionFormat = NAME_None;
+	/** Uncompressed size of block. Blocks of save file section are compressed in parallel. */
+	UPROPERTY(Config)
+	int32 SaveCompressionBlockSize = 256 * 1024;
+
+	/** Game thread only snapshots save data, serialization and file I/O run on a worker thread */
+	bool bUseAsyncSaves = true;
+	/** Max number of save files that can be written at the same time */
+	int32 MaxPendingSaves = 2;
+	/** Save only actors and components changed since previous save */
+	bool bUseDeltaSaves = true;
+	/** Max number of delta saves in a row, then full save is written */
+	int32 MaxDeltaChainLength = 8;
 	/** Used to avoid double @OnLevelDeserialized invocation */
 	bool bIgnoreOnActorSpawnedCallback = false;
 
@@ -4,16 +4,77 @@
 #include "Subsystems/SaveSubsystem/SaveSubsystemTypes.h"
 #include "SaveSubsystem.h"
 #include "Engine/LevelStreaming.h"
+#include "Serialization/ArchiveUObject.h"
 
 DEFINE_LOG_CATEGORY(LogSaveSubsystem);
 
-FSaveSubsystemArchive::FSaveSubsystemArchive(FArchive& InInnerArchive, bool bInLoadIfFindFails)
-	: FObjectAndNameAsStringProxyArchive(InInnerArchive, bInLoadIfFindFails)
+FSaveSubsystemArchive::FSaveSubsystemArchive(FArchive& InInnerArchive, FSaveDataNameTable& InNameTable)
+	: FArchiveProxy(InInnerArchive)
+	, NameTable(InNameTable)
 {
 	ArIsSaveGame = true;
 	ArNoDelta = true;
 }
 
+FArchive& FSaveSubsystemArchive::operator<<(FName& Name)
+{
+	int32 NameIndex = INDEX_NONE;
+	if (IsLoading())
+	{
+		InnerArchive << NameIndex;
+		Name = NameTable.GetName(NameIndex);
+	}
+	else
+	{
+		NameIndex = NameTable.AddName(Name);
+		InnerArchive << NameIndex;
+	}
+
+	return *this;
+}
+
+FArchive& FSaveSubsystemArchive::operator<<(UObject*& Object)
+{
+	int32 ObjectIndex = INDEX_NONE;
+	if (IsLoading())
+	{
+		InnerArchive << ObjectIndex;
+		Object = NameTable.ResolveObject(ObjectIndex);
+	}
+	else
+	{
+		ObjectIndex = NameTable.AddObject(Object);
+		InnerArchive << ObjectIndex;
+	}
+
+	return *this;
+}
+
+FArchive& FSaveSubsystemArchive::operator<<(FWeakObjectPtr& Value)
+{
+	return FArchiveUObject::SerializeWeakObjectPtr(*this, Value);
+}
+
+FArchive& FSaveSubsystemArchive::operator<<(FSoftObjectPtr& Value)
+{
+	return FArchiveUObject::SerializeSoftObjectPtr(*this, Value);
+}
+
+FArchive& FSaveSubsystemArchive::operator<<(FSoftObjectPath& Value)
+{
+	return FArchiveUObject::SerializeSoftObjectPath(*this, Value);
+}
+
+FArchive& FSaveSubsystemArchive::operator<<(FLazyObjectPtr& Value)
+{
+	return FArchiveUObject::SerializeLazyObjectPtr(*this, Value);
+}
+
+FString FSaveSubsystemArchive::GetArchiveName() const
+{
+	return TEXT("FSaveSubsystemArchive");
+}
+
 //
 FSaveDirectoryVisitor::FSaveDirectoryVisitor(TArray<int32>& InSaveIds)
 	: SaveIds(InSaveIds)
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Serialization/ArchiveProxy.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Async/Future.h"
 #include "SaveData.h"
 #include "SaveSubsystemTypes.generated.h"
 
@@ -11,11 +13,23 @@ DECLARE_LOG_CATEGORY_EXTERN(LogSaveSubsystem, Log, All);
 const FName FileExtensionSave = TEXT("save");
 
 /**
- * Used for loading and saving.
+ * Used for loading and saving of objects raw data.
+ * Names and object references are stored as indices to the name table of the save.
  */
-struct FSaveSubsystemArchive : public FObjectAndNameAsStringProxyArchive
+struct FSaveSubsystemArchive : public FArchiveProxy
 {
-	FSaveSubsystemArchive(FArchive& InInnerArchive, bool bInLoadIfFindFails);
+	FSaveSubsystemArchive(FArchive& InInnerArchive, FSaveDataNameTable& InNameTable);
+
+	virtual FArchive& operator<<(FName& Name) override;
+	virtual FArchive& operator<<(UObject*& Object) override;
+	virtual FArchive& operator<<(FWeakObjectPtr& Value) override;
+	virtual FArchive& operator<<(FSoftObjectPtr& Value) override;
+	virtual FArchive& operator<<(FSoftObjectPath& Value) override;
+	virtual FArchive& operator<<(FLazyObjectPtr& Value) override;
+	virtual FString GetArchiveName() const override;
+
+private:
+	FSaveDataNameTable& NameTable;
 };
 
 /**
@@ -31,6 +45,24 @@ private:
 	TArray<int32>& SaveIds;
 };
 
+/**
+ * Save file write that is running on a worker thread.
+ */
+struct FPendingSave
+{
+	int32 SaveId = 0;
+	TFuture<bool> Result;
+};
+
+/**
+ * Content hashes of level data that was written to the last save. Used to find changed actors and components for delta saves.
+ */
+struct FLevelSaveDataHashes
+{
+	TMap<FName, uint32> ActorHashes;
+	TMap<FName, TMap<FName, uint32>> ComponentHashes;
+};
+
 /**
  * Used to change bool value for scope.
  */
@@ -0,0 +1,10 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Significance/GCSignificanceManager.h"
+
+UGCSignificanceManager::UGCSignificanceManager()
+{
+	// Significance values of the game start from SignificanceValueVeryHith = 0 and grow with distance.
+	bSortSignificanceAscending = true;
+}
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SignificanceManager.h"
+#include "GCSignificanceManager.generated.h"
+
+/**
+ * Significance manager of the game. Lower significance value means more significant object,
+ * so with several viewpoints the most significant one is the closest view.
+ */
+UCLASS()
+class GAMECODE_API UGCSignificanceManager : public USignificanceManager
+{
+	GENERATED_BODY()
+
+public:
+	UGCSignificanceManager();
+
+};
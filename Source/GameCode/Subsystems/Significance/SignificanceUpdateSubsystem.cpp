@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Significance/SignificanceUpdateSubsystem.h"
+#include "SignificanceManager.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_SignificanceUpdate, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Viewpoints"), STAT_SignificanceViewpoints, STATGROUP_Game);
+
+void USignificanceUpdateSubsystem::Deinitialize()
+{
+	Viewpoints.Empty();
+
+	Super::Deinitialize();
+}
+
+void USignificanceUpdateSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < UpdateInterval)
+	{
+		return;
+	}
+
+	UpdateSignificance();
+}
+
+ETickableTickType USignificanceUpdateSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool USignificanceUpdateSubsystem::IsTickable() const
+{
+	return GetWorld()->IsGameWorld();
+}
+
+TStatId USignificanceUpdateSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USignificanceUpdateSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* USignificanceUpdateSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void USignificanceUpdateSubsystem::UpdateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_SignificanceUpdate);
+
+	TimeSinceUpdate = 0.0f;
+
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
+	if (!IsValid(SignificanceManager))
+	{
+		return;
+	}
+
+	GatherViewpoints();
+	SET_DWORD_STAT(STAT_SignificanceViewpoints, Viewpoints.Num());
+
+	// Without viewpoints every object would get the lowest significance.
+	if (Viewpoints.Num() == 0)
+	{
+		return;
+	}
+
+	// Significance functions of all objects are evaluated by the manager in parallel, post significance functions are sequential.
+	SignificanceManager->Update(Viewpoints);
+}
+
+void USignificanceUpdateSubsystem::GatherViewpoints()
+{
+	Viewpoints.Reset();
+
+	for (FConstPlayerControllerIterator PlayerControllerIterator = GetWorld()->GetPlayerControllerIterator(); PlayerControllerIterator; ++PlayerControllerIterator)
+	{
+		const APlayerController* PlayerController = PlayerControllerIterator->Get();
+		if (!IsValid(PlayerController))
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		if (PlayerController->IsLocalController())
+		{
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		}
+		else
+		{
+			const APawn* Pawn = PlayerController->GetPawn();
+			if (!bUseRemotePlayerViewpoints || !IsValid(Pawn))
+			{
+				continue;
+			}
+
+			Pawn->GetActorEyesViewPoint(ViewLocation, ViewRotation);
+		}
+
+		Viewpoints.Emplace(ViewRotation, ViewLocation);
+	}
+}
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "SignificanceUpdateSubsystem.generated.h"
+
+/**
+ * Updates significance manager of the world once with viewpoints of all players.
+ * Local players use their camera view, remote players on the server use eyes of their pawns.
+ */
+UCLASS(Config = Game)
+class GAMECODE_API USignificanceUpdateSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/** Updates significance with current viewpoints, doesn't wait for @UpdateInterval */
+	void UpdateSignificance();
+
+private:
+	void GatherViewpoints();
+
+	TArray<FTransform> Viewpoints;
+	float TimeSinceUpdate = 0.0f;
+
+	/** Seconds between significance updates, 0 updates every frame */
+	UPROPERTY(Config)
+	float UpdateInterval = 0.0f;
+
+	/** Use pawns of remote players as viewpoints on the server, on dedicated server they are the only viewpoints */
+	UPROPERTY(Config)
+	bool bUseRemotePlayerViewpoints = true;
+
+};
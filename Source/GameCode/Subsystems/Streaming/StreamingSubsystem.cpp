@@ -2,6 +2,17 @@
 #include "StreamingSubsystem.h"
 #include "StreamingSubsystemManager.h"
 #include "StreamingSubsystemVolume.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tick"), STAT_StreamingSubsystemTick, STATGROUP_StreamingSubsystem);
+DECLARE_CYCLE_STAT(TEXT("Update Player Volumes"), STAT_StreamingSubsystemUpdatePlayerVolumes, STATGROUP_StreamingSubsystem);
+DECLARE_CYCLE_STAT(TEXT("Update Prefetch"), STAT_StreamingSubsystemUpdatePrefetch, STATGROUP_StreamingSubsystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Loading Levels"), STAT_StreamingSubsystemLoadingLevels, STATGROUP_StreamingSubsystem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Visible Levels"), STAT_StreamingSubsystemVisibleLevels, STATGROUP_StreamingSubsystem);
+DECLARE_MEMORY_STAT(TEXT("Prefetch Memory"), STAT_StreamingSubsystemPrefetchMemory, STATGROUP_StreamingSubsystem);
 
 void UStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -11,6 +22,8 @@ void UStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UStreamingSubsystem::OnPreLoadMap);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UStreamingSubsystem::OnPostLoadMapWithWorld);
 
+	Telemetry.SetMaxLoads(MaxTelemetryLoads);
+
 	CreateStreamingLevelManagers(GetWorld());
 }
 
@@ -43,9 +56,279 @@ UWorld* UStreamingSubsystem::GetWorld() const
 	return nullptr;
 }
 
-void UStreamingSubsystem::OnVolumeOverlapBegin(AStreamingSubsystemVolume* SubsystemVolume)
+void UStreamingSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_StreamingSubsystemTick);
+
+	TimeSinceVolumeQuery += DeltaTime;
+	if (TimeSinceVolumeQuery >= VolumeQueryInterval)
+	{
+		UpdatePlayerVolumes();
+	}
+
+	int32 LoadingLevelCount = 0;
+	int32 VisibleLevelCount = 0;
+	for (const TPair<FString, UStreamingSubsystemManager*>& Manager : StreamingLevelManagers)
+	{
+		if (!IsValid(Manager.Value))
+		{
+			continue;
+		}
+
+		// Undilated time of the last frame, the level was loading during it.
+		Manager.Value->RecordFrameTime(FApp::GetDeltaTime());
+		Manager.Value->UpdateLoadState();
+
+		const EStreamingLevelLoadState LoadState = Manager.Value->GetLoadState();
+		if (LoadState == EStreamingLevelLoadState::Visible)
+		{
+			++VisibleLevelCount;
+		}
+		else if (LoadState != EStreamingLevelLoadState::Unloaded && LoadState != EStreamingLevelLoadState::Unloading)
+		{
+			++LoadingLevelCount;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_StreamingSubsystemLoadingLevels, LoadingLevelCount);
+	SET_DWORD_STAT(STAT_StreamingSubsystemVisibleLevels, VisibleLevelCount);
+
+	if (bUsePrefetch)
+	{
+		UpdatePrefetch();
+	}
+
+	int32 AsyncLoadCount = 0;
+	int32 VisibilityChangeCount = 0;
+	TArray<UStreamingSubsystemManager*> PendingManagers;
+	TArray<UStreamingSubsystemManager*> LoadedManagers;
+
+	for (const TPair<FString, UStreamingSubsystemManager*>& Manager : StreamingLevelManagers)
+	{
+		if (!IsValid(Manager.Value) || !Manager.Value->IsAsyncStreaming())
+		{
+			continue;
+		}
+
+		switch (Manager.Value->GetLoadState())
+		{
+			case EStreamingLevelLoadState::Pending:
+				PendingManagers.Add(Manager.Value);
+				break;
+			case EStreamingLevelLoadState::Loading:
+				++AsyncLoadCount;
+				break;
+			case EStreamingLevelLoadState::Loaded:
+				if (!Manager.Value->IsPrefetchOnly())
+				{
+					LoadedManagers.Add(Manager.Value);
+				}
+				break;
+			case EStreamingLevelLoadState::MakingVisible:
+				++VisibilityChangeCount;
+				break;
+			default:
+				break;
+		}
+	}
+
+	SET_MEMORY_STAT(STAT_StreamingSubsystemPrefetchMemory, GetPrefetchMemoryBytes());
+
+	// Loads requested by volumes go first, prefetch loads use the rest.
+	PendingManagers.StableSort([](const UStreamingSubsystemManager& First, const UStreamingSubsystemManager& Second) { return !First.IsPrefetchOnly() && Second.IsPrefetchOnly(); });
+
+	for (UStreamingSubsystemManager* Manager : PendingManagers)
+	{
+		if (AsyncLoadCount >= MaxConcurrentAsyncLoads)
+		{
+			break;
+		}
+
+		Manager->StartAsyncLoad();
+		++AsyncLoadCount;
+	}
+
+	if (LoadedManagers.Num() == 0 || VisibilityChangeCount >= MaxConcurrentVisibilityChanges)
+	{
+		return;
+	}
+
+	// Frame is already over the budget, adding a level to the world now would make the hitch worse.
+	if (DeltaTime > HitchBudgetSeconds && PostponedVisibilityFrames < MaxPostponedVisibilityFrames)
+	{
+		++PostponedVisibilityFrames;
+		return;
+	}
+
+	PostponedVisibilityFrames = 0;
+
+	// Only one visibility change is started per frame.
+	LoadedManagers[0]->StartMakingVisible();
+
+}
+
+ETickableTickType UStreamingSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UStreamingSubsystem::IsTickable() const
+{
+	return StreamingLevelManagers.Num() > 0;
+}
+
+TStatId UStreamingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStreamingSubsystem, STATGROUP_Tickables);
+}
+
+void UStreamingSubsystem::RegisterVolume(AStreamingSubsystemVolume* SubsystemVolume)
+{
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::RegisterVolume(): %s, SubsystemVolume: %s"), *GetNameSafe(this), *GetNameSafe(SubsystemVolume));
+
+	StreamingVolumes.AddUnique(SubsystemVolume);
+	bIsVolumeGridDirty = true;
+
+	// Player can start inside the volume.
+	TimeSinceVolumeQuery = VolumeQueryInterval;
+}
+
+void UStreamingSubsystem::UnregisterVolume(AStreamingSubsystemVolume* SubsystemVolume)
+{
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::UnregisterVolume(): %s, SubsystemVolume: %s"), *GetNameSafe(this), *GetNameSafe(SubsystemVolume));
+
+	StreamingVolumes.Remove(SubsystemVolume);
+	bIsVolumeGridDirty = true;
+
+	for (TPair<TWeakObjectPtr<const AController>, TArray<TWeakObjectPtr<AStreamingSubsystemVolume>>>& Player : PlayerVolumes)
+	{
+		Player.Value.Remove(SubsystemVolume);
+	}
+
+	if (VolumePlayerCounts.Remove(SubsystemVolume) > 0)
+	{
+		OnVolumeExited(SubsystemVolume);
+	}
+}
+
+void UStreamingSubsystem::UpdatePlayerVolumes()
 {
-	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::OnVolumeOverlapBegin(): %s, SubsystemVolume: %s"), *GetNameSafe(this), *GetNameSafe(SubsystemVolume));
+	SCOPE_CYCLE_COUNTER(STAT_StreamingSubsystemUpdatePlayerVolumes);
+
+	TimeSinceVolumeQuery = 0.0f;
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World) || !CanUseSubsystem())
+	{
+		return;
+	}
+
+	if (bIsVolumeGridDirty)
+	{
+		VolumeGrid.Build(StreamingVolumes, VolumeGridCellSize);
+		bIsVolumeGridDirty = false;
+	}
+
+	// Server has controllers of all players, client has only local ones.
+	TArray<AStreamingSubsystemVolume*> ContainingVolumes;
+	for (FConstPlayerControllerIterator PlayerIterator = World->GetPlayerControllerIterator(); PlayerIterator; ++PlayerIterator)
+	{
+		const APlayerController* Player = PlayerIterator->Get();
+		if (!IsValid(Player))
+		{
+			continue;
+		}
+
+		ContainingVolumes.Reset();
+		const APawn* Pawn = Player->GetPawn();
+		if (IsValid(Pawn))
+		{
+			VolumeGrid.QueryLocation(Pawn->GetActorLocation(), ContainingVolumes);
+		}
+
+		UpdatePlayerVolumes(Player, ContainingVolumes);
+	}
+
+	// Players that left the game exit all their volumes.
+	for (TMap<TWeakObjectPtr<const AController>, TArray<TWeakObjectPtr<AStreamingSubsystemVolume>>>::TIterator PlayerIterator = PlayerVolumes.CreateIterator(); PlayerIterator; ++PlayerIterator)
+	{
+		if (PlayerIterator->Key.IsValid())
+		{
+			continue;
+		}
+
+		for (const TWeakObjectPtr<AStreamingSubsystemVolume>& Volume : PlayerIterator->Value)
+		{
+			OnPlayerExitedVolume(Volume.Get());
+		}
+
+		PlayerIterator.RemoveCurrent();
+	}
+}
+
+void UStreamingSubsystem::UpdatePlayerVolumes(const AController* Player, const TArray<AStreamingSubsystemVolume*>& ContainingVolumes)
+{
+	TArray<TWeakObjectPtr<AStreamingSubsystemVolume>>& CurrentVolumes = PlayerVolumes.FindOrAdd(Player);
+
+	for (int32 i = CurrentVolumes.Num() - 1; i >= 0; --i)
+	{
+		AStreamingSubsystemVolume* Volume = CurrentVolumes[i].Get();
+		if (!ContainingVolumes.Contains(Volume))
+		{
+			CurrentVolumes.RemoveAtSwap(i);
+			OnPlayerExitedVolume(Volume);
+		}
+	}
+
+	for (AStreamingSubsystemVolume* Volume : ContainingVolumes)
+	{
+		if (!CurrentVolumes.Contains(Volume))
+		{
+			CurrentVolumes.Add(Volume);
+			OnPlayerEnteredVolume(Volume);
+		}
+	}
+}
+
+void UStreamingSubsystem::OnPlayerEnteredVolume(AStreamingSubsystemVolume* SubsystemVolume)
+{
+	int32& PlayerCount = VolumePlayerCounts.FindOrAdd(SubsystemVolume);
+	++PlayerCount;
+	if (PlayerCount == 1)
+	{
+		OnVolumeEntered(SubsystemVolume);
+	}
+}
+
+void UStreamingSubsystem::OnPlayerExitedVolume(AStreamingSubsystemVolume* SubsystemVolume)
+{
+	// Unregistered volume has already been exited.
+	int32* PlayerCount = VolumePlayerCounts.Find(SubsystemVolume);
+	if (!IsValid(SubsystemVolume) || PlayerCount == nullptr)
+	{
+		return;
+	}
+
+	--(*PlayerCount);
+	if (*PlayerCount <= 0)
+	{
+		VolumePlayerCounts.Remove(SubsystemVolume);
+		OnVolumeExited(SubsystemVolume);
+	}
+}
+
+void UStreamingSubsystem::ResetPlayerVolumes()
+{
+	PlayerVolumes.Empty();
+	VolumePlayerCounts.Empty();
+	VolumeGrid.Empty();
+	bIsVolumeGridDirty = true;
+	TimeSinceVolumeQuery = 0.0f;
+}
+
+void UStreamingSubsystem::OnVolumeEntered(AStreamingSubsystemVolume* SubsystemVolume)
+{
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::OnVolumeEntered(): %s, SubsystemVolume: %s"), *GetNameSafe(this), *GetNameSafe(SubsystemVolume));
 
 	for (const FString& LevelToLoad : SubsystemVolume->GetLevelsToLoad())
 	{
@@ -70,9 +353,9 @@ void UStreamingSubsystem::OnVolumeOverlapBegin(AStreamingSubsystemVolume* Subsys
 	}
 }
 
-void UStreamingSubsystem::OnVolumeOverlapEnd(AStreamingSubsystemVolume* SubsystemVolume)
+void UStreamingSubsystem::OnVolumeExited(AStreamingSubsystemVolume* SubsystemVolume)
 {
-	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::OnVolumeOverlapBegin(): %s, SubsystemVolume: %s"), *GetNameSafe(this), *GetNameSafe(SubsystemVolume));
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::OnVolumeExited(): %s, SubsystemVolume: %s"), *GetNameSafe(this), *GetNameSafe(SubsystemVolume));
 
 	for (const FString& LevelToLoad : SubsystemVolume->GetLevelsToLoad())
 	{
@@ -125,6 +408,7 @@ void UStreamingSubsystem::CreateStreamingLevelManagers(UWorld* World)
 
 		UStreamingSubsystemManager* Manager = NewObject<UStreamingSubsystemManager>(this);
 		Manager->Initialize(Level, ShortLevelName);
+		Manager->OnLoadStateChanged.AddUObject(this, &UStreamingSubsystem::OnLevelLoadStateChanged);
 
 		StreamingLevelManagers.Add(ShortLevelName, Manager);
 	}
@@ -144,6 +428,9 @@ void UStreamingSubsystem::RemoveStreamingLevelManagers()
 	}
 
 	StreamingLevelManagers.Empty();
+	PostponedVisibilityFrames = 0;
+
+	ResetPlayerVolumes();
 }
 
 void UStreamingSubsystem::OnPreLoadMap(const FString& MapName)
@@ -175,3 +462,224 @@ bool UStreamingSubsystem::FindStreamingLevelManager(const FString& LevelName, US
 	return true;
 }
 
+void UStreamingSubsystem::OnLevelLoadStateChanged(UStreamingSubsystemManager* LevelManager, EStreamingLevelLoadState LoadState)
+{
+	FStreamingLevelLoadStats LoadStats;
+	if (LoadState == EStreamingLevelLoadState::Visible && LevelManager->ConsumeLoadStats(LoadStats))
+	{
+		UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::OnLevelLoadStateChanged(): %s, LevelName: %s, Loaded: %.2f ms, Visible: %.2f ms, Max frame: %.2f ms, Memory delta: %lld KB"),
+			*GetNameSafe(this), *LoadStats.LevelName, LoadStats.TimeToLoaded * 1000.0, LoadStats.TimeToVisible * 1000.0, LoadStats.MaxFrameTime * 1000.0, LoadStats.MemoryDeltaBytes / 1024);
+
+		Telemetry.AddLoad(LoadStats);
+	}
+
+	OnStreamingLevelLoadStateChanged.Broadcast(LevelManager, LoadState);
+}
+
+void UStreamingSubsystem::UpdatePrefetch()
+{
+	SCOPE_CYCLE_COUNTER(STAT_StreamingSubsystemUpdatePrefetch);
+
+	UWorld* World = GetWorld();
+	const float CurrentTime = World->GetTimeSeconds();
+
+	if (bIsVolumeGridDirty)
+	{
+		VolumeGrid.Build(StreamingVolumes, VolumeGridCellSize);
+		bIsVolumeGridDirty = false;
+	}
+
+	// Volumes that are entered sooner by any player are prefetched first.
+	TArray<TPair<float, AStreamingSubsystemVolume*>> VolumesToEnter;
+	TArray<AStreamingSubsystemVolume*> CandidateVolumes;
+	for (FConstPlayerControllerIterator PlayerIterator = World->GetPlayerControllerIterator(); PlayerIterator; ++PlayerIterator)
+	{
+		const APlayerController* Player = PlayerIterator->Get();
+		const APawn* PlayerPawn = IsValid(Player) ? Player->GetPawn() : nullptr;
+		if (!IsValid(PlayerPawn))
+		{
+			continue;
+		}
+
+		const FVector Location = PlayerPawn->GetActorLocation();
+		const FVector Velocity = PlayerPawn->GetVelocity();
+		if (Velocity.SizeSquared() < FMath::Square(MinPrefetchSpeed))
+		{
+			continue;
+		}
+
+		// Only volumes near the look ahead segment are ray tested.
+		const FVector LookAheadLocation = Location + Velocity * PrefetchLookAheadSeconds;
+		CandidateVolumes.Reset();
+		VolumeGrid.QueryBox(FBox(Location.ComponentMin(LookAheadLocation), Location.ComponentMax(LookAheadLocation)), CandidateVolumes);
+
+		for (AStreamingSubsystemVolume* Volume : CandidateVolumes)
+		{
+			float TimeToEnter = 0.0f;
+			if (GetTimeToEnterBox(Volume->GetStreamingBounds(), Location, Velocity, TimeToEnter) && TimeToEnter > 0.0f && TimeToEnter <= PrefetchLookAheadSeconds)
+			{
+				VolumesToEnter.Emplace(TimeToEnter, Volume);
+			}
+		}
+	}
+
+	VolumesToEnter.Sort([](const TPair<float, AStreamingSubsystemVolume*>& First, const TPair<float, AStreamingSubsystemVolume*>& Second) { return First.Key < Second.Key; });
+
+	for (const TPair<float, AStreamingSubsystemVolume*>& VolumeToEnter : VolumesToEnter)
+	{
+		for (const FString& LevelToLoad : VolumeToEnter.Value->GetLevelsToLoad())
+		{
+			UStreamingSubsystemManager* LevelManager = nullptr;
+			if (!FindStreamingLevelManager(LevelToLoad, LevelManager) || !LevelManager->CanPrefetch())
+			{
+				continue;
+			}
+
+			const bool bIsNewPrefetch = LevelManager->GetLoadState() == EStreamingLevelLoadState::Unloaded;
+			if (bIsNewPrefetch && !MakePrefetchMemory(LevelManager->GetEstimatedMemoryBytes(), CurrentTime))
+			{
+				continue;
+			}
+
+			LevelManager->Prefetch(CurrentTime);
+		}
+	}
+
+	// Budget can be changed at runtime, keep prefetched levels within it.
+	MakePrefetchMemory(0, CurrentTime);
+
+}
+
+bool UStreamingSubsystem::MakePrefetchMemory(int64 RequiredBytes, float CurrentTime)
+{
+	const int64 BudgetBytes = (int64)PrefetchMemoryBudgetMB * 1024 * 1024;
+	int64 UsedBytes = GetPrefetchMemoryBytes();
+	if (UsedBytes + RequiredBytes <= BudgetBytes)
+	{
+		return true;
+	}
+
+	TArray<UStreamingSubsystemManager*> PrefetchedManagers;
+	for (const TPair<FString, UStreamingSubsystemManager*>& Manager : StreamingLevelManagers)
+	{
+		// Levels that are needed in this frame are never evicted.
+		if (IsValid(Manager.Value) && Manager.Value->IsPrefetchOnly() && Manager.Value->GetLastPrefetchTime() < CurrentTime)
+		{
+			PrefetchedManagers.Add(Manager.Value);
+		}
+	}
+
+	PrefetchedManagers.Sort([](const UStreamingSubsystemManager& First, const UStreamingSubsystemManager& Second) { return First.GetLastPrefetchTime() < Second.GetLastPrefetchTime(); });
+
+	for (UStreamingSubsystemManager* Manager : PrefetchedManagers)
+	{
+		if (UsedBytes + RequiredBytes <= BudgetBytes)
+		{
+			break;
+		}
+
+		UsedBytes -= Manager->GetEstimatedMemoryBytes();
+		Manager->EvictPrefetch();
+	}
+
+	return UsedBytes + RequiredBytes <= BudgetBytes;
+}
+
+int64 UStreamingSubsystem::GetPrefetchMemoryBytes() const
+{
+	int64 PrefetchMemoryBytes = 0;
+	for (const TPair<FString, UStreamingSubsystemManager*>& Manager : StreamingLevelManagers)
+	{
+		if (IsValid(Manager.Value) && Manager.Value->IsPrefetchOnly())
+		{
+			PrefetchMemoryBytes += Manager.Value->GetEstimatedMemoryBytes();
+		}
+	}
+
+	return PrefetchMemoryBytes;
+}
+
+bool UStreamingSubsystem::GetTimeToEnterBox(const FBox& Box, const FVector& Location, const FVector& Velocity, float& OutTime)
+{
+	// Slab test of the ray from @Location along @Velocity.
+	float EnterTime = 0.0f;
+	float ExitTime = MAX_flt;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		if (FMath::IsNearlyZero(Velocity[Axis]))
+		{
+			if (Location[Axis] < Box.Min[Axis] || Location[Axis] > Box.Max[Axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		const float InvVelocity = 1.0f / Velocity[Axis];
+		float AxisEnterTime = (Box.Min[Axis] - Location[Axis]) * InvVelocity;
+		float AxisExitTime = (Box.Max[Axis] - Location[Axis]) * InvVelocity;
+		if (AxisEnterTime > AxisExitTime)
+		{
+			Swap(AxisEnterTime, AxisExitTime);
+		}
+
+		EnterTime = FMath::Max(EnterTime, AxisEnterTime);
+		ExitTime = FMath::Min(ExitTime, AxisExitTime);
+		if (EnterTime > ExitTime)
+		{
+			return false;
+		}
+	}
+
+	OutTime = EnterTime;
+	return true;
+}
+
+void UStreamingSubsystem::StreamingStats()
+{
+#if !UE_BUILD_SHIPPING
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::StreamingStats(): %i loads"), Telemetry.Num());
+
+	const TArray<TPair<const TCHAR*, TFunction<double(const FStreamingLevelLoadStats&)>>> Metrics = {
+		{ TEXT("Time to loaded, ms"), [](const FStreamingLevelLoadStats& LoadStats) { return LoadStats.TimeToLoaded * 1000.0; } },
+		{ TEXT("Time to visible, ms"), [](const FStreamingLevelLoadStats& LoadStats) { return LoadStats.TimeToVisible * 1000.0; } },
+		{ TEXT("Max frame, ms"), [](const FStreamingLevelLoadStats& LoadStats) { return LoadStats.MaxFrameTime * 1000.0; } },
+		{ TEXT("Memory delta, KB"), [](const FStreamingLevelLoadStats& LoadStats) { return LoadStats.MemoryDeltaBytes / 1024.0; } }
+	};
+
+	for (const TPair<const TCHAR*, TFunction<double(const FStreamingLevelLoadStats&)>>& Metric : Metrics)
+	{
+		double P50 = 0.0;
+		double P90 = 0.0;
+		double P99 = 0.0;
+		double Max = 0.0;
+		if (!Telemetry.GetPercentile(Metric.Value, 50.0f, P50))
+		{
+			return;
+		}
+
+		Telemetry.GetPercentile(Metric.Value, 90.0f, P90);
+		Telemetry.GetPercentile(Metric.Value, 99.0f, P99);
+		Telemetry.GetPercentile(Metric.Value, 100.0f, Max);
+
+		UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::StreamingStats(): %s: p50 %.2f, p90 %.2f, p99 %.2f, max %.2f"), Metric.Key, P50, P90, P99, Max);
+	}
+#endif
+}
+
+void UStreamingSubsystem::DumpStreamingStats()
+{
+#if !UE_BUILD_SHIPPING
+	const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("StreamingSubsystem"), FString::Printf(TEXT("StreamingStats-%s.csv"), *FDateTime::Now().ToString()));
+	const bool bIsSuccess = Telemetry.WriteCsv(FilePath);
+
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingSubsystem::DumpStreamingStats(): %i loads, File: %s, Success: %i"), Telemetry.Num(), *FilePath, bIsSuccess);
+#endif
+}
+
+void UStreamingSubsystem::ResetStreamingStats()
+{
+#if !UE_BUILD_SHIPPING
+	Telemetry.Empty();
+#endif
+}
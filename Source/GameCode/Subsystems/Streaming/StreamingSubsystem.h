@@ -4,13 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "StreamingSubsystemManager.h"
+#include "StreamingSubsystemTypes.h"
 #include "StreamingSubsystem.generated.h"
 
-class UStreamingSubsystemManager;
 class AStreamingSubsystemVolume;
 
-UCLASS()
-class GAMECODE_API UStreamingSubsystem : public UGameInstanceSubsystem
+UCLASS(Config = Game)
+class GAMECODE_API UStreamingSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 	
@@ -20,19 +22,114 @@ public:
 
 	virtual UWorld* GetWorld() const override;
 
-	void OnVolumeOverlapBegin(AStreamingSubsystemVolume* SubsystemVolume);
-	void OnVolumeOverlapEnd(AStreamingSubsystemVolume* SubsystemVolume);
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	/** Called when load state of any streaming level is changed */
+	FOnStreamingLevelLoadStateChanged OnStreamingLevelLoadStateChanged;
 
 	bool CanUseSubsystem() const;
 
+	void RegisterVolume(AStreamingSubsystemVolume* SubsystemVolume);
+	void UnregisterVolume(AStreamingSubsystemVolume* SubsystemVolume);
+
+	/** Finds volumes that contain players and sends enter and exit events. Called with @VolumeQueryInterval, can be called to update immediately. */
+	void UpdatePlayerVolumes();
+
 private:
 	void CreateStreamingLevelManagers(UWorld* World);
 	void RemoveStreamingLevelManagers();
 	void OnPreLoadMap(const FString& MapName);
 	void OnPostLoadMapWithWorld(UWorld* LoadedWorld);
 	bool FindStreamingLevelManager(const FString& LevelName, UStreamingSubsystemManager*& LevelManager);
+	void OnLevelLoadStateChanged(UStreamingSubsystemManager* LevelManager, EStreamingLevelLoadState LoadState);
+
+	void OnVolumeEntered(AStreamingSubsystemVolume* SubsystemVolume);
+	void OnVolumeExited(AStreamingSubsystemVolume* SubsystemVolume);
+	void UpdatePlayerVolumes(const AController* Player, const TArray<AStreamingSubsystemVolume*>& ContainingVolumes);
+	void OnPlayerEnteredVolume(AStreamingSubsystemVolume* SubsystemVolume);
+	void OnPlayerExitedVolume(AStreamingSubsystemVolume* SubsystemVolume);
+	void ResetPlayerVolumes();
+
+	/** Prefetches levels of volumes players are going to enter soon, evicts least recently needed prefetched levels over the memory budget. */
+	void UpdatePrefetch();
+	bool MakePrefetchMemory(int64 RequiredBytes, float CurrentTime);
+	int64 GetPrefetchMemoryBytes() const;
+	static bool GetTimeToEnterBox(const FBox& Box, const FVector& Location, const FVector& Velocity, float& OutTime);
+
+	/** Logs percentiles of load latency, longest frame and memory delta of recent level loads. */
+	UFUNCTION(Exec)
+	void StreamingStats();
+
+	/** Writes recent level loads to a CSV file in the profiling directory. */
+	UFUNCTION(Exec)
+	void DumpStreamingStats();
+
+	UFUNCTION(Exec)
+	void ResetStreamingStats();
 
 	UPROPERTY(Transient)
 	TMap<FString, UStreamingSubsystemManager*> StreamingLevelManagers;
 
+	TArray<TWeakObjectPtr<AStreamingSubsystemVolume>> StreamingVolumes;
+
+	/** Built from @StreamingVolumes when it is used first time after volumes are changed */
+	FStreamingVolumeGrid VolumeGrid;
+	bool bIsVolumeGridDirty = true;
+
+	/** Volumes that contain each player */
+	TMap<TWeakObjectPtr<const AController>, TArray<TWeakObjectPtr<AStreamingSubsystemVolume>>> PlayerVolumes;
+	/** Number of players inside each volume. Volume is entered by the first player and exited by the last one. */
+	TMap<TWeakObjectPtr<AStreamingSubsystemVolume>, int32> VolumePlayerCounts;
+	float TimeSinceVolumeQuery = 0.0f;
+
+	FStreamingTelemetry Telemetry;
+
+	/** Number of recent level loads kept for streaming stats */
+	UPROPERTY(Config)
+	int32 MaxTelemetryLoads = 256;
+
+	UPROPERTY(Config)
+	float VolumeGridCellSize = 10000.0f;
+
+	/** Player locations are checked against volumes with this interval */
+	UPROPERTY(Config)
+	float VolumeQueryInterval = 0.1f;
+
+	/** Max number of async level loads at the same time */
+	UPROPERTY(Config)
+	int32 MaxConcurrentAsyncLoads = 2;
+
+	/** Async loaded levels are made visible one by one, so add to world work is spread across frames */
+	UPROPERTY(Config)
+	int32 MaxConcurrentVisibilityChanges = 1;
+
+	/** New visibility change is postponed while frame time is over the budget */
+	UPROPERTY(Config)
+	float HitchBudgetSeconds = 1.0f / 30.0f;
+
+	/** Max number of frames in a row visibility change can be postponed */
+	UPROPERTY(Config)
+	int32 MaxPostponedVisibilityFrames = 10;
+
+	int32 PostponedVisibilityFrames = 0;
+
+	/** Load levels ahead of players using their velocity */
+	UPROPERTY(Config)
+	bool bUsePrefetch = true;
+
+	/** Levels of volumes a player enters within this time are prefetched */
+	UPROPERTY(Config)
+	float PrefetchLookAheadSeconds = 3.0f;
+
+	/** Player moving slower doesn't prefetch anything */
+	UPROPERTY(Config)
+	float MinPrefetchSpeed = 100.0f;
+
+	/** Max estimated memory of levels that are loaded only by prefetch */
+	UPROPERTY(Config)
+	int32 PrefetchMemoryBudgetMB = 256;
+
 };
@@ -3,9 +3,15 @@
 
 #include "Subsystems/Streaming/StreamingSubsystemManager.h"
 #include "StreamingSubsystemVolume.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/MiscTrace.h"
 
 DEFINE_LOG_CATEGORY(LogStreamingSubsystem)
 
+CSV_DEFINE_CATEGORY(StreamingSubsystem, true);
+
 
 void UStreamingSubsystemManager::Initialize(ULevelStreaming* InStreamingLevel, const FString& InLevelName)
 {
@@ -23,6 +29,18 @@ void UStreamingSubsystemManager::Initialize(ULevelStreaming* InStreamingLevel, c
 	StreamingLevel->OnLevelShown.AddUniqueDynamic(this, &UStreamingSubsystemManager::OnLevelLoaded);
 	StreamingLevel->OnLevelHidden.AddUniqueDynamic(this, &UStreamingSubsystemManager::OnLevelUnloaded);
 
+	bShouldBeLoaded = StreamingLevel->ShouldBeLoaded();
+	DefaultStreamingPriority = StreamingLevel->GetPriority();
+
+	const FString PackageName = UWorld::RemovePIEPrefix(StreamingLevel->GetWorldAssetPackageName());
+	FString PackageFileName;
+	if (FPackageName::TryConvertLongPackageNameToFilename(PackageName, PackageFileName, FPackageName::GetMapPackageExtension()))
+	{
+		EstimatedMemoryBytes = FMath::Max<int64>(IFileManager::Get().FileSize(*PackageFileName), 0);
+	}
+
+	UpdateLoadState();
+
 }
 
 void UStreamingSubsystemManager::Deinitialize()
@@ -36,6 +54,7 @@ void UStreamingSubsystemManager::Deinitialize()
 	}
 
 	StreamingLevel.Reset();
+	OnLoadStateChanged.Clear();
 }
 
 void UStreamingSubsystemManager::AddLoadRequest(AStreamingSubsystemVolume* SubsystemVolume)
@@ -50,7 +69,7 @@ void UStreamingSubsystemManager::AddLoadRequest(AStreamingSubsystemVolume* Subsy
 
 	if (LoadRequests.Num() == 1 && UnloadRequests.Num() == 0)
 	{
-		LoadLevel();
+		LoadLevel(SubsystemVolume->IsAsyncStreaming());
 	}
 
 }
@@ -67,7 +86,7 @@ void UStreamingSubsystemManager::RemoveLoadRequest(AStreamingSubsystemVolume* Su
 
 	if (LoadRequests.Num() == 0 && UnloadRequests.Num() == 0)
 	{
-		UnloadLevel();
+		UnloadLevel(SubsystemVolume->IsAsyncStreaming());
 	}
 
 }
@@ -82,9 +101,11 @@ void UStreamingSubsystemManager::AddUnloadRequest(AStreamingSubsystemVolume* Sub
 
 	UnloadRequests.AddUnique(SubsystemVolume);
 
+	EvictPrefetch();
+
 	if (UnloadRequests.Num() == 1 && LoadRequests.Num() != 0)
 	{
-		UnloadLevel();
+		UnloadLevel(SubsystemVolume->IsAsyncStreaming());
 	}
 }
 
@@ -100,7 +121,7 @@ void UStreamingSubsystemManager::RemoveUnloadRequest(AStreamingSubsystemVolume*
 
 	if (UnloadRequests.Num() == 0 && LoadRequests.Num() != 0)
 	{
-		LoadLevel();
+		LoadLevel(SubsystemVolume->IsAsyncStreaming());
 	}
 }
 
@@ -109,6 +130,132 @@ ULevelStreaming::ECurrentState UStreamingSubsystemManager::GetStreamingLevelStat
 	return StreamingLevelState;
 }
 
+const FString& UStreamingSubsystemManager::GetLevelName() const
+{
+	return LevelName;
+}
+
+EStreamingLevelLoadState UStreamingSubsystemManager::GetLoadState() const
+{
+	return LoadState;
+}
+
+bool UStreamingSubsystemManager::IsAsyncStreaming() const
+{
+	return bIsAsyncStreaming;
+}
+
+void UStreamingSubsystemManager::UpdateLoadState()
+{
+	if (!StreamingLevel.IsValid())
+	{
+		return;
+	}
+
+	StreamingLevelState = StreamingLevel->GetCurrentState();
+
+	const bool bShouldLevelBeLoaded = bShouldBeLoaded || bIsPrefetched;
+
+	EStreamingLevelLoadState NewLoadState = LoadState;
+	switch (StreamingLevelState)
+	{
+		case ULevelStreaming::ECurrentState::Removed:
+		case ULevelStreaming::ECurrentState::Unloaded:
+		{
+			if (!bShouldLevelBeLoaded)
+			{
+				NewLoadState = EStreamingLevelLoadState::Unloaded;
+			}
+			else if (LoadState != EStreamingLevelLoadState::Pending)
+			{
+				// Load is requested, but the world has not started it yet.
+				NewLoadState = EStreamingLevelLoadState::Loading;
+			}
+			break;
+		}
+		case ULevelStreaming::ECurrentState::FailedToLoad:
+		{
+			if (LoadState != EStreamingLevelLoadState::Pending)
+			{
+				UE_CLOG(LoadState != EStreamingLevelLoadState::Unloaded, LogStreamingSubsystem, Warning, TEXT("UStreamingLevelManager::UpdateLoadState(): LevelName: %s, Failed to load!"), *LevelName);
+				NewLoadState = EStreamingLevelLoadState::Unloaded;
+			}
+			break;
+		}
+		case ULevelStreaming::ECurrentState::Loading:
+		{
+			NewLoadState = bShouldLevelBeLoaded ? EStreamingLevelLoadState::Loading : EStreamingLevelLoadState::Unloading;
+			break;
+		}
+		case ULevelStreaming::ECurrentState::LoadedNotVisible:
+		{
+			if (!bShouldLevelBeLoaded)
+			{
+				NewLoadState = EStreamingLevelLoadState::Unloading;
+			}
+			else if (LoadState != EStreamingLevelLoadState::MakingVisible)
+			{
+				NewLoadState = EStreamingLevelLoadState::Loaded;
+			}
+			break;
+		}
+		case ULevelStreaming::ECurrentState::MakingVisible:
+		{
+			NewLoadState = EStreamingLevelLoadState::MakingVisible;
+			break;
+		}
+		case ULevelStreaming::ECurrentState::LoadedVisible:
+		{
+			NewLoadState = bShouldLevelBeLoaded ? EStreamingLevelLoadState::Visible : EStreamingLevelLoadState::Unloading;
+			break;
+		}
+		case ULevelStreaming::ECurrentState::MakingInvisible:
+		{
+			NewLoadState = EStreamingLevelLoadState::Unloading;
+			break;
+		}
+		default:
+			break;
+	}
+
+	SetLoadState(NewLoadState);
+
+}
+
+void UStreamingSubsystemManager::StartAsyncLoad()
+{
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::StartAsyncLoad(): LevelName: %s"), *LevelName);
+	if (!StreamingLevel.IsValid() || LoadState != EStreamingLevelLoadState::Pending)
+	{
+		return;
+	}
+
+	// Level stays hidden after load, so adding it to the world can wait for the hitch budget.
+	StreamingLevel->SetPriority(IsPrefetchOnly() ? DefaultStreamingPriority - 1 : DefaultStreamingPriority);
+	StreamingLevel->bShouldBlockOnLoad = false;
+	StreamingLevel->SetShouldBeLoaded(true);
+	StreamingLevel->SetShouldBeVisible(false);
+
+	SetLoadState(EStreamingLevelLoadState::Loading);
+
+}
+
+void UStreamingSubsystemManager::StartMakingVisible()
+{
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::StartMakingVisible(): LevelName: %s"), *LevelName);
+	if (!StreamingLevel.IsValid() || LoadState != EStreamingLevelLoadState::Loaded || IsPrefetchOnly())
+	{
+		return;
+	}
+
+	// Non blocking level is added to the world incrementally over several frames.
+	StreamingLevel->bShouldBlockOnLoad = false;
+	StreamingLevel->SetShouldBeVisible(true);
+
+	SetLoadState(EStreamingLevelLoadState::MakingVisible);
+
+}
+
 void UStreamingSubsystemManager::OnLevelLoaded()
 {
 	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::OnLevelLoaded(): LevelName: %s"), *LevelName);
@@ -117,7 +264,7 @@ void UStreamingSubsystemManager::OnLevelLoaded()
 		return;
 	}
 
-	StreamingLevelState = StreamingLevel->GetCurrentState();
+	UpdateLoadState();
 
 }
 
@@ -129,35 +276,249 @@ void UStreamingSubsystemManager::OnLevelUnloaded()
 		return;
 	}
 
-	StreamingLevelState = StreamingLevel->GetCurrentState();
+	UpdateLoadState();
 
 }
 
-void UStreamingSubsystemManager::LoadLevel()
+void UStreamingSubsystemManager::LoadLevel(bool bAsync)
 {
-	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::LoadLevel(): LevelName: %s"), *LevelName);
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::LoadLevel(): LevelName: %s, Async: %i"), *LevelName, bAsync);
 	if (!StreamingLevel.IsValid())
 	{
 		return;
 	}
 
+	bIsAsyncStreaming = bAsync;
+	StartLoadStats();
+
+	bShouldBeLoaded = true;
+	bIsPrefetched = false;
+	StreamingLevel->SetPriority(DefaultStreamingPriority);
+
+	if (!bAsync)
+	{
+		StreamingLevel->SetShouldBeLoaded(true);
+		StreamingLevel->SetShouldBeVisible(true);
+		StreamingLevel->bShouldBlockOnLoad = true;
+
+		UpdateLoadState();
+		return;
+	}
+
+	StreamingLevel->bShouldBlockOnLoad = false;
+
+	const ULevelStreaming::ECurrentState CurrentState = StreamingLevel->GetCurrentState();
+	if (CurrentState == ULevelStreaming::ECurrentState::Removed || CurrentState == ULevelStreaming::ECurrentState::Unloaded || CurrentState == ULevelStreaming::ECurrentState::FailedToLoad)
+	{
+		// Load is started by the subsystem.
+		SetLoadState(EStreamingLevelLoadState::Pending);
+		return;
+	}
+
+	// Level is still loading or loaded, cancel its unload.
 	StreamingLevel->SetShouldBeLoaded(true);
-	StreamingLevel->SetShouldBeVisible(true);
-	StreamingLevel->bShouldBlockOnLoad = true;
+	if (CurrentState == ULevelStreaming::ECurrentState::MakingVisible || StreamingLevel->IsLevelVisible())
+	{
+		StreamingLevel->SetShouldBeVisible(true);
+	}
 
+	UpdateLoadState();
 
 }
 
-void UStreamingSubsystemManager::UnloadLevel()
+void UStreamingSubsystemManager::UnloadLevel(bool bAsync)
 {
-	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::UnloadLevel(): LevelName: %s"), *LevelName);
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::UnloadLevel(): LevelName: %s, Async: %i"), *LevelName, bAsync);
 	if (!StreamingLevel.IsValid())
 	{
 		return;
 	}
 
+	bShouldBeLoaded = false;
+	bIsAsyncStreaming = bAsync;
+	bIsPrefetched = false;
+
 	StreamingLevel->SetShouldBeLoaded(false);
 	StreamingLevel->SetShouldBeVisible(false);
-	StreamingLevel->bShouldBlockOnUnload = true;
+	StreamingLevel->bShouldBlockOnUnload = !bAsync;
 
+	UpdateLoadState();
+
+}
+
+void UStreamingSubsystemManager::Prefetch(float CurrentTime)
+{
+	if (!StreamingLevel.IsValid() || !CanPrefetch())
+	{
+		return;
+	}
+
+	LastPrefetchTime = CurrentTime;
+	if (bIsPrefetched || bShouldBeLoaded)
+	{
+		return;
+	}
+
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::Prefetch(): LevelName: %s"), *LevelName);
+
+	bIsPrefetched = true;
+	bIsAsyncStreaming = true;
+
+	const ULevelStreaming::ECurrentState CurrentState = StreamingLevel->GetCurrentState();
+	if (CurrentState == ULevelStreaming::ECurrentState::Removed || CurrentState == ULevelStreaming::ECurrentState::Unloaded || CurrentState == ULevelStreaming::ECurrentState::FailedToLoad)
+	{
+		// Load is started by the subsystem after loads requested by volumes.
+		SetLoadState(EStreamingLevelLoadState::Pending);
+		return;
+	}
+
+	// Level is still loading or loaded, keep it loaded but hidden.
+	StreamingLevel->bShouldBlockOnUnload = false;
+	StreamingLevel->SetShouldBeLoaded(true);
+	StreamingLevel->SetShouldBeVisible(false);
+
+	UpdateLoadState();
+
+}
+
+void UStreamingSubsystemManager::EvictPrefetch()
+{
+	if (!StreamingLevel.IsValid() || !IsPrefetchOnly())
+	{
+		return;
+	}
+
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::EvictPrefetch(): LevelName: %s"), *LevelName);
+
+	bIsPrefetched = false;
+
+	StreamingLevel->SetShouldBeLoaded(false);
+	StreamingLevel->SetShouldBeVisible(false);
+	StreamingLevel->bShouldBlockOnUnload = false;
+
+	UpdateLoadState();
+
+}
+
+bool UStreamingSubsystemManager::CanPrefetch() const
+{
+	return UnloadRequests.Num() == 0;
+}
+
+bool UStreamingSubsystemManager::IsPrefetchOnly() const
+{
+	return bIsPrefetched && !bShouldBeLoaded;
+}
+
+float UStreamingSubsystemManager::GetLastPrefetchTime() const
+{
+	return LastPrefetchTime;
+}
+
+int64 UStreamingSubsystemManager::GetEstimatedMemoryBytes() const
+{
+	return EstimatedMemoryBytes;
+}
+
+void UStreamingSubsystemManager::RecordFrameTime(double FrameTime)
+{
+	if (bIsLoadStatsTracked)
+	{
+		LoadStats.MaxFrameTime = FMath::Max(LoadStats.MaxFrameTime, FrameTime);
+	}
+}
+
+bool UStreamingSubsystemManager::ConsumeLoadStats(FStreamingLevelLoadStats& OutLoadStats)
+{
+	if (!bHasCompletedLoadStats)
+	{
+		return false;
+	}
+
+	OutLoadStats = LoadStats;
+	bHasCompletedLoadStats = false;
+
+	return true;
+}
+
+void UStreamingSubsystemManager::SetLoadState(EStreamingLevelLoadState NewLoadState)
+{
+	if (LoadState == NewLoadState)
+	{
+		return;
+	}
+
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("UStreamingLevelManager::SetLoadState(): LevelName: %s, State: %s"), *LevelName, *UEnum::GetValueAsString(NewLoadState));
+
+	// Markers line up level state changes with Insights and CSV profiler captures.
+	const FString LoadStateName = StaticEnum<EStreamingLevelLoadState>()->GetNameStringByValue((int64)NewLoadState);
+	TRACE_BOOKMARK(TEXT("Streaming %s %s"), *LevelName, *LoadStateName);
+	CSV_EVENT(StreamingSubsystem, TEXT("%s %s"), *LevelName, *LoadStateName);
+
+	UpdateLoadStats(NewLoadState);
+
+	LoadState = NewLoadState;
+	OnLoadStateChanged.Broadcast(this, LoadState);
+
+}
+
+void UStreamingSubsystemManager::StartLoadStats()
+{
+	// Level that is already visible doesn't load again.
+	if (LoadState == EStreamingLevelLoadState::Visible)
+	{
+		return;
+	}
+
+	LoadStats = FStreamingLevelLoadStats();
+	LoadStats.LevelName = LevelName;
+	LoadStats.RequestTime = FPlatformTime::Seconds();
+	LoadStats.RequestUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	LoadStats.bIsAsync = bIsAsyncStreaming;
+	LoadStats.bWasPrefetched = bIsPrefetched;
+
+	bIsLoadStatsTracked = true;
+	bHasCompletedLoadStats = false;
+}
+
+void UStreamingSubsystemManager::UpdateLoadStats(EStreamingLevelLoadState NewLoadState)
+{
+	if (!bIsLoadStatsTracked)
+	{
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	switch (NewLoadState)
+	{
+		case EStreamingLevelLoadState::Loaded:
+		case EStreamingLevelLoadState::MakingVisible:
+		case EStreamingLevelLoadState::Visible:
+		{
+			// Blocking load can skip the loaded state.
+			if (LoadStats.TimeToLoaded < 0.0)
+			{
+				LoadStats.TimeToLoaded = CurrentTime - LoadStats.RequestTime;
+			}
+
+			if (NewLoadState == EStreamingLevelLoadState::Visible)
+			{
+				LoadStats.TimeToVisible = CurrentTime - LoadStats.RequestTime;
+				LoadStats.MemoryDeltaBytes = (int64)FPlatformMemory::GetStats().UsedPhysical - (int64)LoadStats.RequestUsedPhysical;
+
+				bIsLoadStatsTracked = false;
+				bHasCompletedLoadStats = true;
+			}
+			break;
+		}
+		case EStreamingLevelLoadState::Unloading:
+		case EStreamingLevelLoadState::Unloaded:
+		{
+			// Load is cancelled.
+			bIsLoadStatsTracked = false;
+			break;
+		}
+		default:
+			break;
+	}
 }
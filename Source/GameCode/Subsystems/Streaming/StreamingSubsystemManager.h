@@ -5,11 +5,29 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Engine/LevelStreaming.h"
+#include "StreamingSubsystemTypes.h"
 #include "StreamingSubsystemManager.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogStreamingSubsystem, Log, All);
 
+UENUM(BlueprintType)
+enum class EStreamingLevelLoadState : uint8
+{
+	Unloaded,
+	/** Async load is requested and waits for its turn */
+	Pending,
+	Loading,
+	/** Loaded but not visible yet. Waits for the hitch budget. */
+	Loaded,
+	MakingVisible,
+	Visible,
+	Unloading
+};
+
 class AStreamingSubsystemVolume;
+class UStreamingSubsystemManager;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnStreamingLevelLoadStateChanged, UStreamingSubsystemManager*, EStreamingLevelLoadState);
 
 
 UCLASS()
@@ -29,6 +47,36 @@ public:
 
 	ULevelStreaming::ECurrentState GetStreamingLevelState() const;
 
+	const FString& GetLevelName() const;
+	EStreamingLevelLoadState GetLoadState() const;
+	bool IsAsyncStreaming() const;
+
+	/** Syncs load state with the streaming level state. Broadcasts @OnLoadStateChanged on change. */
+	void UpdateLoadState();
+
+	/** Async streaming only. Called by the subsystem when pending load can start. */
+	void StartAsyncLoad();
+	/** Async streaming only. Called by the subsystem when loaded level fits into the hitch budget. */
+	void StartMakingVisible();
+
+	/** Loads level in background with low priority and keeps it hidden until it is requested by a volume. */
+	void Prefetch(float CurrentTime);
+	/** Unloads prefetched level that is not requested by any volume. */
+	void EvictPrefetch();
+	bool CanPrefetch() const;
+	/** Level is loaded only by prefetch, no volume requests it yet */
+	bool IsPrefetchOnly() const;
+	float GetLastPrefetchTime() const;
+	/** Estimated from the level package size */
+	int64 GetEstimatedMemoryBytes() const;
+
+	/** Called every frame, keeps the longest frame of the tracked load */
+	void RecordFrameTime(double FrameTime);
+	/** Returns stats of the load that became visible since the last call */
+	bool ConsumeLoadStats(FStreamingLevelLoadStats& OutLoadStats);
+
+	FOnStreamingLevelLoadStateChanged OnLoadStateChanged;
+
 private:
 	UFUNCTION()
 	void OnLevelLoaded();
@@ -36,11 +84,26 @@ private:
 	UFUNCTION()
 	void OnLevelUnloaded();
 
-	void LoadLevel();
-	void UnloadLevel();
+	void LoadLevel(bool bAsync);
+	void UnloadLevel(bool bAsync);
+	void SetLoadState(EStreamingLevelLoadState NewLoadState);
+	void StartLoadStats();
+	void UpdateLoadStats(EStreamingLevelLoadState NewLoadState);
 
 	FString LevelName;
 	ULevelStreaming::ECurrentState StreamingLevelState = ULevelStreaming::ECurrentState::Unloaded;
+	EStreamingLevelLoadState LoadState = EStreamingLevelLoadState::Unloaded;
+	/** Level is loaded with async package loading and time sliced visibility change */
+	bool bIsAsyncStreaming = false;
+	bool bShouldBeLoaded = false;
+	bool bIsPrefetched = false;
+	/** Last time prefetcher predicted that the level is needed */
+	float LastPrefetchTime = 0.0f;
+	int64 EstimatedMemoryBytes = 0;
+	int32 DefaultStreamingPriority = 0;
+	FStreamingLevelLoadStats LoadStats;
+	bool bIsLoadStatsTracked = false;
+	bool bHasCompletedLoadStats = false;
 	TWeakObjectPtr<ULevelStreaming> StreamingLevel;
 	TArray<TWeakObjectPtr<AStreamingSubsystemVolume>> LoadRequests;
 	TArray<TWeakObjectPtr<AStreamingSubsystemVolume>> UnloadRequests;
@@ -0,0 +1,222 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/Streaming/StreamingSubsystemTypes.h"
+#include "StreamingSubsystemVolume.h"
+#include "Misc/FileHelper.h"
+
+namespace StreamingVolumeGrid
+{
+	const int32 MaxCellsPerVolume = 1024;
+}
+
+void FStreamingVolumeGrid::Build(const TArray<TWeakObjectPtr<AStreamingSubsystemVolume>>& Volumes, float InCellSize)
+{
+	Empty();
+
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	Entries.Reserve(Volumes.Num());
+
+	for (const TWeakObjectPtr<AStreamingSubsystemVolume>& Volume : Volumes)
+	{
+		if (!Volume.IsValid())
+		{
+			continue;
+		}
+
+		const int32 EntryIndex = Entries.Num();
+		FVolumeEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Volume = Volume;
+		Entry.Bounds = Volume->GetStreamingBounds();
+
+		const FIntPoint MinCell = GetCell(Entry.Bounds.Min);
+		const FIntPoint MaxCell = GetCell(Entry.Bounds.Max);
+		const int64 CellCount = (int64)(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+		if (CellCount > StreamingVolumeGrid::MaxCellsPerVolume)
+		{
+			OversizedEntries.Add(EntryIndex);
+			continue;
+		}
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				Cells.FindOrAdd(FIntPoint(X, Y)).Add(EntryIndex);
+			}
+		}
+	}
+}
+
+void FStreamingVolumeGrid::Empty()
+{
+	Entries.Empty();
+	Cells.Empty();
+	OversizedEntries.Empty();
+}
+
+void FStreamingVolumeGrid::QueryLocation(const FVector& Location, TArray<AStreamingSubsystemVolume*>& OutVolumes) const
+{
+	// Volume is added to every cell it covers, so a single cell is enough for a point.
+	const TArray<int32>* CellEntries = Cells.Find(GetCell(Location));
+	if (CellEntries != nullptr)
+	{
+		for (const int32 EntryIndex : *CellEntries)
+		{
+			const FVolumeEntry& Entry = Entries[EntryIndex];
+			if (Entry.Volume.IsValid() && Entry.Bounds.IsInsideOrOn(Location))
+			{
+				OutVolumes.Add(Entry.Volume.Get());
+			}
+		}
+	}
+
+	for (const int32 EntryIndex : OversizedEntries)
+	{
+		const FVolumeEntry& Entry = Entries[EntryIndex];
+		if (Entry.Volume.IsValid() && Entry.Bounds.IsInsideOrOn(Location))
+		{
+			OutVolumes.Add(Entry.Volume.Get());
+		}
+	}
+}
+
+void FStreamingVolumeGrid::QueryBox(const FBox& Box, TArray<AStreamingSubsystemVolume*>& OutVolumes) const
+{
+	TBitArray<> VisitedEntries(false, Entries.Num());
+
+	const FIntPoint MinCell = GetCell(Box.Min);
+	const FIntPoint MaxCell = GetCell(Box.Max);
+	const int64 CellCount = (int64)(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+
+	if (CellCount > Cells.Num())
+	{
+		// Box is bigger than the populated part of the grid, check populated cells only.
+		for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+		{
+			if (Cell.Key.X < MinCell.X || Cell.Key.X > MaxCell.X || Cell.Key.Y < MinCell.Y || Cell.Key.Y > MaxCell.Y)
+			{
+				continue;
+			}
+
+			for (const int32 EntryIndex : Cell.Value)
+			{
+				const FVolumeEntry& Entry = Entries[EntryIndex];
+				if (!VisitedEntries[EntryIndex] && Entry.Volume.IsValid() && Entry.Bounds.Intersect(Box))
+				{
+					OutVolumes.Add(Entry.Volume.Get());
+				}
+				VisitedEntries[EntryIndex] = true;
+			}
+		}
+	}
+	else
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				const TArray<int32>* CellEntries = Cells.Find(FIntPoint(X, Y));
+				if (CellEntries == nullptr)
+				{
+					continue;
+				}
+
+				for (const int32 EntryIndex : *CellEntries)
+				{
+					const FVolumeEntry& Entry = Entries[EntryIndex];
+					if (!VisitedEntries[EntryIndex] && Entry.Volume.IsValid() && Entry.Bounds.Intersect(Box))
+					{
+						OutVolumes.Add(Entry.Volume.Get());
+					}
+					VisitedEntries[EntryIndex] = true;
+				}
+			}
+		}
+	}
+
+	AddOversizedEntries(Box, VisitedEntries, OutVolumes);
+}
+
+FIntPoint FStreamingVolumeGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void FStreamingVolumeGrid::AddOversizedEntries(const FBox& Box, TBitArray<>& VisitedEntries, TArray<AStreamingSubsystemVolume*>& OutVolumes) const
+{
+	for (const int32 EntryIndex : OversizedEntries)
+	{
+		const FVolumeEntry& Entry = Entries[EntryIndex];
+		if (!VisitedEntries[EntryIndex] && Entry.Volume.IsValid() && Entry.Bounds.Intersect(Box))
+		{
+			OutVolumes.Add(Entry.Volume.Get());
+		}
+		VisitedEntries[EntryIndex] = true;
+	}
+}
+
+void FStreamingTelemetry::SetMaxLoads(int32 InMaxLoads)
+{
+	MaxLoads = FMath::Max(InMaxLoads, 1);
+	Empty();
+}
+
+void FStreamingTelemetry::AddLoad(const FStreamingLevelLoadStats& LoadStats)
+{
+	if (Loads.Num() < MaxLoads)
+	{
+		Loads.Add(LoadStats);
+		return;
+	}
+
+	Loads[NextLoadIndex] = LoadStats;
+	NextLoadIndex = (NextLoadIndex + 1) % MaxLoads;
+}
+
+void FStreamingTelemetry::Empty()
+{
+	Loads.Empty();
+	NextLoadIndex = 0;
+}
+
+int32 FStreamingTelemetry::Num() const
+{
+	return Loads.Num();
+}
+
+bool FStreamingTelemetry::GetPercentile(TFunctionRef<double(const FStreamingLevelLoadStats&)> Metric, float Percentile, double& OutValue) const
+{
+	if (Loads.Num() == 0)
+	{
+		return false;
+	}
+
+	TArray<double> Values;
+	Values.Reserve(Loads.Num());
+	for (const FStreamingLevelLoadStats& LoadStats : Loads)
+	{
+		Values.Add(Metric(LoadStats));
+	}
+
+	Values.Sort();
+	const int32 Rank = FMath::CeilToInt(FMath::Clamp(Percentile, 0.0f, 100.0f) / 100.0f * Values.Num());
+	OutValue = Values[FMath::Clamp(Rank - 1, 0, Values.Num() - 1)];
+
+	return true;
+}
+
+bool FStreamingTelemetry::WriteCsv(const FString& FilePath) const
+{
+	FString Csv = TEXT("Level,RequestTime,TimeToLoadedMs,TimeToVisibleMs,MaxFrameTimeMs,MemoryDeltaKB,Async,Prefetched\n");
+	for (int32 i = 0; i < Loads.Num(); ++i)
+	{
+		const FStreamingLevelLoadStats& LoadStats = Loads[(NextLoadIndex + i) % Loads.Num()];
+		Csv += FString::Printf(TEXT("%s,%.3f,%.2f,%.2f,%.2f,%lld,%i,%i\n"),
+			*LoadStats.LevelName, LoadStats.RequestTime,
+			LoadStats.TimeToLoaded * 1000.0, LoadStats.TimeToVisible * 1000.0, LoadStats.MaxFrameTime * 1000.0,
+			LoadStats.MemoryDeltaBytes / 1024, LoadStats.bIsAsync, LoadStats.bWasPrefetched);
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AStreamingSubsystemVolume;
+
+DECLARE_STATS_GROUP(TEXT("StreamingSubsystem"), STATGROUP_StreamingSubsystem, STATCAT_Advanced);
+
+/**
+ * Uniform grid of streaming volume bounds. Grid is 2D, because volumes are spread horizontally.
+ */
+struct FStreamingVolumeGrid
+{
+public:
+	void Build(const TArray<TWeakObjectPtr<AStreamingSubsystemVolume>>& Volumes, float InCellSize);
+	void Empty();
+
+	/** Volumes that contain @Location */
+	void QueryLocation(const FVector& Location, TArray<AStreamingSubsystemVolume*>& OutVolumes) const;
+	/** Volumes that intersect @Box */
+	void QueryBox(const FBox& Box, TArray<AStreamingSubsystemVolume*>& OutVolumes) const;
+
+private:
+	struct FVolumeEntry
+	{
+		TWeakObjectPtr<AStreamingSubsystemVolume> Volume;
+		FBox Bounds;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+	void AddOversizedEntries(const FBox& Box, TBitArray<>& VisitedEntries, TArray<AStreamingSubsystemVolume*>& OutVolumes) const;
+
+	TArray<FVolumeEntry> Entries;
+	TMap<FIntPoint, TArray<int32>> Cells;
+	/** Volumes that cover too many cells are checked on every query */
+	TArray<int32> OversizedEntries;
+	float CellSize = 1.0f;
+};
+
+/**
+ * Timings of a single level load, from the request until the level is visible.
+ */
+struct FStreamingLevelLoadStats
+{
+	FString LevelName;
+	/** Platform time of the load request */
+	double RequestTime = 0.0;
+	/** Seconds from the request */
+	double TimeToLoaded = -1.0;
+	double TimeToVisible = -1.0;
+	/** Longest game thread frame while the level was loaded and made visible */
+	double MaxFrameTime = 0.0;
+	/** Used physical memory at the request, used to get @MemoryDeltaBytes */
+	uint64 RequestUsedPhysical = 0;
+	int64 MemoryDeltaBytes = 0;
+	bool bIsAsync = false;
+	/** Level was prefetched before it was requested */
+	bool bWasPrefetched = false;
+};
+
+/**
+ * Rolling history of completed level loads.
+ */
+class FStreamingTelemetry
+{
+public:
+	void SetMaxLoads(int32 InMaxLoads);
+	void AddLoad(const FStreamingLevelLoadStats& LoadStats);
+	void Empty();
+	int32 Num() const;
+
+	/** Nearest rank percentile of @Metric over recorded loads. Returns false if there are no loads. */
+	bool GetPercentile(TFunctionRef<double(const FStreamingLevelLoadStats&)> Metric, float Percentile, double& OutValue) const;
+
+	/** Writes all recorded loads, oldest first */
+	bool WriteCsv(const FString& FilePath) const;
+
+private:
+	TArray<FStreamingLevelLoadStats> Loads;
+	/** Index of the oldest load when history is full */
+	int32 NextLoadIndex = 0;
+	int32 MaxLoads = 256;
+};
@@ -5,6 +5,8 @@
 #include "GameFramework/Character.h"
 #include "StreamingSubsystemVolume.h"
 #include "StreamingSubsystemManager.h"
+#include "StreamingSubsystem.h"
+#include "Engine/GameInstance.h"
 
 void UStreamingSubsystemUtils::CheckCharacterOverlapStreamingSubsystemVolume(ACharacter* Character)
 {
@@ -14,17 +16,7 @@ void UStreamingSubsystemUtils::CheckCharacterOverlapStreamingSubsystemVolume(ACh
 		return;
 	}
 
-	TSet<AActor*> OverlappingActors;
-	Character->GetOverlappingActors(OverlappingActors, AStreamingSubsystemVolume::StaticClass());
-	for (AActor* OverlappedActor : OverlappingActors)
-	{
-		if (!IsValid(OverlappedActor) || !OverlappedActor->HasActorBegunPlay())
-		{
-			continue;
-		}
-
-		StaticCast<AStreamingSubsystemVolume*>(OverlappedActor)->HandleCharacterOverlapBegin(Character);
-	}
+	UpdatePlayerVolumes(Character->GetWorld());
 
 }
 
@@ -36,16 +28,16 @@ void UStreamingSubsystemUtils::CheckStreamingSubsystemVolumeOverlapCharacter(ASt
 		return;
 	}
 
-	TSet<AActor*> OverlappingActors;
-	SubsystemVolume->GetOverlappingActors(OverlappingActors, ACharacter::StaticClass());
-	for (AActor* OverlappedActor : OverlappingActors)
-	{
-		if (!IsValid(OverlappedActor) || !OverlappedActor->HasActorBegunPlay())
-		{
-			continue;
-		}
+	UpdatePlayerVolumes(SubsystemVolume->GetWorld());
 
-		SubsystemVolume->HandleCharacterOverlapBegin(StaticCast<ACharacter*>(OverlappedActor));
-	}
+}
 
+void UStreamingSubsystemUtils::UpdatePlayerVolumes(const UWorld* World)
+{
+	const UGameInstance* GameInstance = IsValid(World) ? World->GetGameInstance() : nullptr;
+	UStreamingSubsystem* StreamingSubsystem = IsValid(GameInstance) ? GameInstance->GetSubsystem<UStreamingSubsystem>() : nullptr;
+	if (IsValid(StreamingSubsystem))
+	{
+		StreamingSubsystem->UpdatePlayerVolumes();
+	}
 }
@@ -15,10 +15,14 @@ class GAMECODE_API UStreamingSubsystemUtils : public UBlueprintFunctionLibrary
 	GENERATED_BODY()
 
 public:
+	/** Volumes are checked by streaming subsystem with fixed interval, these functions force the check to happen immediately */
 	UFUNCTION(BlueprintCallable, Category = "Streaming Subsystem Utils")
 	static void CheckCharacterOverlapStreamingSubsystemVolume(ACharacter* Character);
 
 	UFUNCTION(BlueprintCallable, Category = "Streaming Subsystem Utils")
 	static void CheckStreamingSubsystemVolumeOverlapCharacter(AStreamingSubsystemVolume* SubsystemVolume);
 
+private:
+	static void UpdatePlayerVolumes(const UWorld* World);
+
 };
@@ -1,15 +1,15 @@
 
 #include "Subsystems/Streaming/StreamingSubsystemVolume.h"
 #include "Components/BoxComponent.h"
-#include "StreamingSubsystemUtils.h"
 #include "StreamingSubsystem.h"
-#include "GameFramework/Character.h"
 #include "StreamingSubsystemManager.h"
 
 AStreamingSubsystemVolume::AStreamingSubsystemVolume()
 {
  	CollisionComponent = CreateDefaultSubobject<UBoxComponent>(TEXT("CollisionComponent"));
 	SetRootComponent(CollisionComponent);
+	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	CollisionComponent->SetGenerateOverlapEvents(false);
 
 }
 
@@ -23,27 +23,14 @@ const TSet<FString>& AStreamingSubsystemVolume::GetLevelsToUnLoad() const
 	return LevelToUnLoad;
 }
 
-void AStreamingSubsystemVolume::HandleCharacterOverlapBegin(ACharacter* Character)
+bool AStreamingSubsystemVolume::IsAsyncStreaming() const
 {
-	UE_LOG(LogStreamingSubsystem, Display, TEXT("AStreamingSubsystemVolume::HandleCharacterOverlapBegin(): %s, Character: %s"), *GetNameSafe(this), *GetNameSafe(Character));
-	if (!StreamingSubsystem.IsValid() || !StreamingSubsystem->CanUseSubsystem())
-	{
-		return;
-	}
-
-	if (!IsValid(Character) || !Character->IsPlayerControlled())
-	{
-		return;
-	}
-
-	if (OverlappedCharacter.IsValid())
-	{
-		return;
-	}
-
-	OverlappedCharacter = Character;
-	StreamingSubsystem->OnVolumeOverlapBegin(this);
+	return bUseAsyncStreaming;
+}
 
+FBox AStreamingSubsystemVolume::GetStreamingBounds() const
+{
+	return CollisionComponent->Bounds.GetBox();
 }
 
 void AStreamingSubsystemVolume::BeginPlay()
@@ -52,30 +39,17 @@ void AStreamingSubsystemVolume::BeginPlay()
 	UE_LOG(LogStreamingSubsystem, Display, TEXT("AStreamingSubsystemVolume::BeginPlay(): %s"), *GetNameSafe(this));
 
 	StreamingSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<UStreamingSubsystem>();
-
-	CollisionComponent->OnComponentBeginOverlap.AddUniqueDynamic(this, &AStreamingSubsystemVolume::OnOverlapBegin);
-	CollisionComponent->OnComponentEndOverlap.AddUniqueDynamic(this, &AStreamingSubsystemVolume::OnOverlapEnd);
-	CollisionComponent->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
-
-	UStreamingSubsystemUtils::CheckStreamingSubsystemVolumeOverlapCharacter(this);
-
-
+	StreamingSubsystem->RegisterVolume(this);
 
 }
 
 void AStreamingSubsystemVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	UE_LOG(LogStreamingSubsystem, Display, TEXT("AStreamingSubsystemVolume::BeginPlay(): %s"), *GetNameSafe(this));
+	UE_LOG(LogStreamingSubsystem, Display, TEXT("AStreamingSubsystemVolume::EndPlay(): %s"), *GetNameSafe(this));
 
-	CollisionComponent->OnComponentBeginOverlap.RemoveDynamic(this, &AStreamingSubsystemVolume::OnOverlapBegin);
-	CollisionComponent->OnComponentEndOverlap.RemoveDynamic(this, &AStreamingSubsystemVolume::OnOverlapEnd);
-	CollisionComponent->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-
-	if (OverlappedCharacter.IsValid())
+	if (StreamingSubsystem.IsValid())
 	{
-		OverlappedCharacter.Reset();
-
-		StreamingSubsystem->OnVolumeOverlapEnd(this);
+		StreamingSubsystem->UnregisterVolume(this);
 	}
 
 	StreamingSubsystem.Reset();
@@ -83,42 +57,3 @@ void AStreamingSubsystemVolume::EndPlay(const EEndPlayReason::Type EndPlayReason
 	Super::EndPlay(EndPlayReason);
 
 }
-
-void AStreamingSubsystemVolume::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	UE_LOG(LogStreamingSubsystem, Display, TEXT("AStreamingSubsystemVolume::OnOverlapBegin(): %s, OtherActor: %s"), *GetNameSafe(this), *GetNameSafe(OtherActor));
-	if (!IsValid(OtherActor))
-	{
-		return;
-	}
-
-	HandleCharacterOverlapBegin(Cast<ACharacter>(OtherActor));
-
-
-}
-
-void AStreamingSubsystemVolume::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, int32 OtherBodyIndex)
-{
-	UE_LOG(LogStreamingSubsystem, Display, TEXT("AStreamingSubsystemVolume::OnOverlapEnd(): %s, OtherActor: %s"), *GetNameSafe(this), *GetNameSafe(OtherActor));
-	if (!StreamingSubsystem.IsValid() || !StreamingSubsystem->CanUseSubsystem())
-	{
-		return;
-	}
-
-	ACharacter* Character = Cast<ACharacter>(OtherActor);
-	if (!IsValid(Character) || !Character->IsPlayerControlled())
-	{
-		return;
-	}
-
-	if (OverlappedCharacter != OtherActor)
-	{
-		return;
-	}
-
-	OverlappedCharacter.Reset();
-	StreamingSubsystem->OnVolumeOverlapEnd(this);
-
-
-}
-
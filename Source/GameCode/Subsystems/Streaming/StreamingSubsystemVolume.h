@@ -8,7 +8,6 @@
 
 class UBoxComponent;
 class UStreamingSubsystem;
-class ACharacter;
 
 
 UCLASS()
@@ -22,20 +21,16 @@ public:
 	const TSet<FString>& GetLevelsToLoad() const;
 	const TSet<FString>& GetLevelsToUnLoad() const;
 
-	void HandleCharacterOverlapBegin(ACharacter* Character);
+	bool IsAsyncStreaming() const;
+
+	/** Streaming subsystem checks player locations against these bounds, box doesn't generate overlaps */
+	FBox GetStreamingBounds() const;
 
 protected:
 	
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	UFUNCTION()
-	void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	UFUNCTION()
-	void OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, int32 OtherBodyIndex);
-
-
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
 	UBoxComponent* CollisionComponent;
 
@@ -45,10 +40,13 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming")
 	TSet<FString> LevelToUnLoad;
 
+	/** Levels are loaded without blocking the game thread and made visible within the hitch budget of the streaming subsystem */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming")
+	bool bUseAsyncStreaming = false;
+
 protected:
 
 	TWeakObjectPtr<UStreamingSubsystem> StreamingSubsystem;
-	TWeakObjectPtr<ACharacter> OverlappedCharacter;
 
 
 };